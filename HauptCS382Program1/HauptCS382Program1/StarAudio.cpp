@@ -0,0 +1,117 @@
+/***********************************************************************/
+/* Filename: StarAudio.cpp                                             */
+/* Non-blocking audio queue: per-frame merging plus service thread.   */
+/***********************************************************************/
+
+#include "StarAudio.h"
+#include <chrono>
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int SERVICE_IDLE_MSEC = 5;                      // Service nap when the queue is empty. //
+
+
+StarAudio::StarAudio(AudioBackend player)
+{
+	backend = player;
+	nbrFrameVoices = 0;
+	posted = 0;
+	merged = 0;
+	queue.reset(new Voice[AUDIO_QUEUE_CAPACITY]);
+	head.store(0);
+	tail.store(0);
+	dropped.store(0);
+	played.store(0);
+	running.store(false);
+}
+
+StarAudio::~StarAudio()
+{
+	Stop();
+}
+
+/* Launch the service thread (the null backend needs none). */
+void StarAudio::Start()
+{
+	if (backend == NULL || running.exchange(true))
+		return;
+	service = thread(&StarAudio::ServiceLoop, this);
+}
+
+/* Stop the service thread; voices still queued are not played. */
+void StarAudio::Stop()
+{
+	if (!running.exchange(false))
+		return;
+	service.join();
+}
+
+/* Ask for a beep. Nothing is played until the frame ends; an identical */
+/* request already made this frame absorbs this one, and requests past */
+/* the per-frame voice cap are discarded.                               */
+void StarAudio::Post(int frequency, int duration)
+{
+	posted++;
+	for (int v = 0; v < nbrFrameVoices; v++)
+	{
+		if (frame[v].frequency == frequency && frame[v].duration == duration)
+		{
+			merged++;
+			return;
+		}
+	}
+	if (nbrFrameVoices == MAX_AUDIO_VOICES_PER_FRAME)
+	{
+		merged++;
+		return;
+	}
+	frame[nbrFrameVoices].frequency = frequency;
+	frame[nbrFrameVoices].duration = duration;
+	nbrFrameVoices++;
+}
+
+/* Hand the frame's voices to the service thread. Never blocks: if the */
+/* backend has fallen a whole queue behind, the voices are dropped.    */
+void StarAudio::EndFrame()
+{
+	if (backend == NULL)
+	{
+		played.fetch_add(nbrFrameVoices, memory_order_relaxed);
+		nbrFrameVoices = 0;
+		return;
+	}
+
+	size_t position = head.load(memory_order_relaxed);
+	for (int v = 0; v < nbrFrameVoices; v++)
+	{
+		if (position - tail.load(memory_order_acquire) == (size_t)AUDIO_QUEUE_CAPACITY)
+		{
+			dropped.fetch_add(nbrFrameVoices - v, memory_order_relaxed);
+			break;
+		}
+		queue[position % AUDIO_QUEUE_CAPACITY] = frame[v];
+		position++;
+	}
+	head.store(position, memory_order_release);
+	nbrFrameVoices = 0;
+}
+
+/* Service thread: play queued voices in order, napping while idle. */
+void StarAudio::ServiceLoop()
+{
+	while (running.load())
+	{
+		size_t position = tail.load(memory_order_relaxed);
+		if (position == head.load(memory_order_acquire))
+		{
+			this_thread::sleep_for(chrono::milliseconds(SERVICE_IDLE_MSEC));
+			continue;
+		}
+		Voice voice = queue[position % AUDIO_QUEUE_CAPACITY];
+		tail.store(position + 1, memory_order_release);
+		backend(voice.frequency, voice.duration);
+		played.fetch_add(1, memory_order_relaxed);
+	}
+}
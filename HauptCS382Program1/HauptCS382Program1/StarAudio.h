@@ -0,0 +1,75 @@
+/***********************************************************************/
+/* Filename: StarAudio.h                                               */
+/* Non-blocking audio queue. The simulation posts beep requests as it */
+/* runs; requests posted during one frame are merged (identical beeps */
+/* become one voice, and only the first few distinct voices are kept) */
+/* and handed to a service thread, which plays them through the       */
+/* backend. The simulation never waits on a beep, so a burst of       */
+/* collisions costs no more frame time than a single one.             */
+/***********************************************************************/
+
+#ifndef STAR_AUDIO_H
+#define STAR_AUDIO_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+const int MAX_AUDIO_VOICES_PER_FRAME = 3;             // Distinct beeps kept from one frame. //
+const int AUDIO_QUEUE_CAPACITY = 16;                  // Voices waiting for the backend.     //
+
+// Plays one beep, blocking for its duration. //
+typedef void (*AudioBackend)(int frequency, int duration);
+
+class StarAudio
+{
+public:
+	/* A NULL backend is the null backend: requests are merged and */
+	/* counted as usual, then discarded at the end of each frame   */
+	/* without starting a service thread.                          */
+	StarAudio(AudioBackend player = NULL);
+	~StarAudio();
+
+	void Start();
+	void Stop();
+
+	void Post(int frequency, int duration);
+	void EndFrame();
+
+	unsigned long Posted() const { return posted; }
+	unsigned long Merged() const { return merged; }
+	unsigned long Dropped() const { return dropped.load(); }
+	unsigned long Played() const { return played.load(); }
+
+private:
+	struct Voice
+	{
+		int frequency;
+		int duration;
+	};
+
+	AudioBackend backend;
+
+	// Voices gathered during the current frame (simulation thread only). //
+	Voice frame[MAX_AUDIO_VOICES_PER_FRAME];
+	int   nbrFrameVoices;
+	unsigned long posted;             // Beep requests received.                     //
+	unsigned long merged;             // Requests folded into another or over the cap. //
+
+	// Single-producer, single-consumer ring of voices to play. //
+	std::unique_ptr<Voice[]> queue;
+	std::atomic<size_t> head;         // Next slot to fill (simulation thread). //
+	std::atomic<size_t> tail;         // Next slot to play (service thread).    //
+	std::atomic<unsigned long> dropped;   // Voices lost to a full queue. //
+	std::atomic<unsigned long> played;
+
+	std::thread service;
+	std::atomic<bool> running;
+
+	void ServiceLoop();
+
+	StarAudio(const StarAudio &);
+	StarAudio &operator=(const StarAudio &);
+};
+
+#endif
@@ -0,0 +1,37 @@
+/***********************************************************************/
+/* Filename: StarClock.cpp                                             */
+/* QueryPerformanceCounter on Windows, CLOCK_MONOTONIC elsewhere;      */
+/* neither is affected by changes to the wall clock.                  */
+/***********************************************************************/
+
+#include "StarClock.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+/* Nanoseconds since an arbitrary fixed point. */
+int64_t ClockNanoseconds()
+{
+	static LARGE_INTEGER frequency = { 0 };
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	// Split the conversion so the multiplication cannot overflow. //
+	int64_t seconds = counter.QuadPart / frequency.QuadPart;
+	int64_t remainder = counter.QuadPart % frequency.QuadPart;
+	return seconds * 1000000000 + remainder * 1000000000 / frequency.QuadPart;
+}
+#else
+#include <time.h>
+
+/* Nanoseconds since an arbitrary fixed point. */
+int64_t ClockNanoseconds()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+#endif
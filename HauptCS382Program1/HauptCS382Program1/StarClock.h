@@ -0,0 +1,22 @@
+/***********************************************************************/
+/* Filename: StarClock.h                                               */
+/* Portable monotonic clock with nanosecond resolution, for pacing    */
+/* the simulation and timing runs. Readings only ever move forward    */
+/* and count from an arbitrary origin, so only differences between    */
+/* them mean anything.                                                */
+/***********************************************************************/
+
+#ifndef STAR_CLOCK_H
+#define STAR_CLOCK_H
+
+#include <cstdint>
+
+int64_t ClockNanoseconds();
+
+/* The same reading in seconds. */
+inline double ClockSeconds()
+{
+	return ClockNanoseconds() * 1e-9;
+}
+
+#endif
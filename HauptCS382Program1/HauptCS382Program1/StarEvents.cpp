@@ -0,0 +1,232 @@
+/***********************************************************************/
+/* Filename: StarEvents.cpp                                            */
+/* Event rings, their consumer threads, and the standard subscribers. */
+/***********************************************************************/
+
+#include "StarEvents.h"
+#include <chrono>
+#include "StarAudio.h"
+#include "StarLog.h"
+#include "StarTrace.h"
+#include "StarWorld.h"
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int CONSUMER_IDLE_MSEC = 1;                     // Consumer nap when its ring is empty. //
+
+
+StarEventBus::StarEventBus(int capacity)
+{
+	size_t size = 2;
+	while (size < (size_t)capacity)
+		size *= 2;
+	mask = size - 1;
+	nbrSubscribers = 0;
+	published = 0;
+	running.store(false);
+}
+
+StarEventBus::~StarEventBus()
+{
+	Stop();
+}
+
+/* Add a consumer of every event published from now on, delivered as  */
+/* the parameterized policy says. Returns false once the bus is       */
+/* running or has MAX_EVENT_SUBSCRIBERS already.                      */
+bool StarEventBus::Subscribe(EventHandler handler, void *context, EventDelivery delivery)
+{
+	if (running.load() || nbrSubscribers == MAX_EVENT_SUBSCRIBERS)
+		return false;
+	Subscriber *subscriber = new Subscriber;
+	subscriber->handler = handler;
+	subscriber->context = context;
+	subscriber->delivery = delivery;
+	subscriber->ring.reset(new StarEvent[mask + 1]);
+	subscriber->head.store(0);
+	subscriber->cachedTail = 0;
+	subscriber->dropped = 0;
+	subscriber->stalls = 0;
+	subscriber->tail.store(0);
+	subscribers[nbrSubscribers++].reset(subscriber);
+	return true;
+}
+
+/* Launch a consumer thread for each subscriber. */
+void StarEventBus::Start()
+{
+	if (running.exchange(true))
+		return;
+	for (int s = 0; s < nbrSubscribers; s++)
+		subscribers[s]->consumer = thread(&StarEventBus::ConsumerLoop, this, subscribers[s].get());
+}
+
+/* Stop the consumer threads once every published event has been */
+/* handled. Call from the publishing thread.                     */
+void StarEventBus::Stop()
+{
+	running.store(false);
+	for (int s = 0; s < nbrSubscribers; s++)
+	{
+		if (subscribers[s]->consumer.joinable())
+			subscribers[s]->consumer.join();
+		subscribers[s]->Drain(mask);
+	}
+}
+
+/* Events, over all subscribers, dropped because a ring was full; */
+/* only drop-when-full subscribers ever lose any.                 */
+unsigned long StarEventBus::Dropped() const
+{
+	unsigned long dropped = 0;
+	for (int s = 0; s < nbrSubscribers; s++)
+		dropped += subscribers[s]->dropped;
+	return dropped;
+}
+
+/* Events, over all subscribers, the publisher held back until a */
+/* lossless subscriber's ring had room.                          */
+unsigned long StarEventBus::Stalls() const
+{
+	unsigned long stalls = 0;
+	for (int s = 0; s < nbrSubscribers; s++)
+		stalls += subscribers[s]->stalls;
+	return stalls;
+}
+
+/* Publisher side: the ring looked full, so refresh the copy of the */
+/* tail. If it really is full, deliver the events here when there   */
+/* is no consumer thread; otherwise wait for the consumer if the    */
+/* subscriber is lossless, or count the event as dropped and return */
+/* false.                                                           */
+bool StarEventBus::Subscriber::MakeRoom(size_t position, size_t mask)
+{
+	cachedTail = tail.load(memory_order_acquire);
+	if (position - cachedTail <= mask)
+		return true;
+	if (!consumer.joinable())
+	{
+		Drain(mask);
+		cachedTail = tail.load(memory_order_relaxed);
+		return true;
+	}
+	if (delivery == DELIVER_LOSSLESS)
+	{
+		stalls++;
+		do
+		{
+			this_thread::yield();
+			cachedTail = tail.load(memory_order_acquire);
+		} while (position - cachedTail > mask);
+		return true;
+	}
+	dropped++;
+	return false;
+}
+
+/* Consumer side: hand every published event to the handler, at most */
+/* two batches (the ring may wrap). Returns false if there were none. */
+bool StarEventBus::Subscriber::Drain(size_t mask)
+{
+	size_t first = tail.load(memory_order_relaxed);
+	size_t last = head.load(memory_order_acquire);
+	if (first == last)
+		return false;
+	while (first != last)
+	{
+		size_t slot = first & mask;
+		size_t count = mask + 1 - slot;
+		if (count > last - first)
+			count = last - first;
+		handler(context, &ring[slot], (int)count);
+		first += count;
+		tail.store(first, memory_order_release);
+	}
+	return true;
+}
+
+/* Consumer thread: drain, nap while idle, and drain once more after */
+/* being told to stop.                                                */
+void StarEventBus::ConsumerLoop(Subscriber *subscriber)
+{
+	while (running.load())
+	{
+		if (!subscriber->Drain(mask))
+			this_thread::sleep_for(chrono::milliseconds(CONSUMER_IDLE_MSEC));
+	}
+	subscriber->Drain(mask);
+}
+
+
+/* Post the game's beeps for the parameterized events to a StarAudio, */
+/* closing its frame at the end of each step.                         */
+void PlayEvents(void *audio, const StarEvent *events, int count)
+{
+	StarAudio *player = (StarAudio *)audio;
+	for (int e = 0; e < count; e++)
+	{
+		const StarEvent &event = events[e];
+		switch (event.type)
+		{
+		case EVENT_COLLISION:
+			// LET THERE BE BEEPING!!!!
+			player->Post(COLLISION_BEEP_FREQUENCY * (event.valueA + event.valueB), COLLISION_BEEP_DURATION);
+			break;
+		case EVENT_FREEZE:
+			player->Post(FREEZE_BEEP_FREQUENCY, FREEZE_BEEP_DURATION);
+			break;
+		case EVENT_UNFREEZE:
+			player->Post(UNFREEZE_BEEP_FREQUENCY, UNFREEZE_BEEP_DURATION);
+			break;
+		case EVENT_STEP_END:
+			player->EndFrame();
+			break;
+		}
+	}
+}
+
+/* Write the collision and display lines for the parameterized events */
+/* to a StarLog.                                                       */
+void LogEvents(void *log, const StarEvent *events, int count)
+{
+	StarLog *debugLog = (StarLog *)log;
+	for (int e = 0; e < count; e++)
+	{
+		const StarEvent &event = events[e];
+		if (event.type != EVENT_COLLISION)
+			continue;
+		STAR_LOG(debugLog, LOG_COLLISION, LOG_INFO, "Collision Detected: %d and %d collisions: %d and %d\nTotal collisions: %llu\nhit",
+			event.starA, event.starB, event.valueA, event.valueB, (unsigned long long)event.count);
+		STAR_LOG(debugLog, LOG_DISPLAY, LOG_DEBUG, "display: starA: %d starB: %d", event.starA, event.starB);
+	}
+}
+
+/* Record the parameterized events in a StarTrace. */
+void TraceEvents(void *trace, const StarEvent *events, int count)
+{
+	StarTrace *recorder = (StarTrace *)trace;
+	for (int e = 0; e < count; e++)
+	{
+		const StarEvent &event = events[e];
+		switch (event.type)
+		{
+		case EVENT_COLLISION:
+			recorder->Record(TRACE_COLLISION, event.tick, event.starA, event.starB);
+			break;
+		case EVENT_FREEZE:
+			recorder->Record(TRACE_FREEZE, event.tick, event.starA, -1, event.valueA);
+			break;
+		case EVENT_UNFREEZE:
+			recorder->Record(TRACE_UNFREEZE, event.tick, event.starA);
+			break;
+		case EVENT_STAGE_CHANGE:
+			recorder->Record(TRACE_STAGE_CHANGE, event.tick, event.starA, -1, event.valueA);
+			break;
+		case EVENT_GAME_OVER:
+			recorder->Record(TRACE_GAME_OVER, event.tick, event.starA);
+			break;
+		}
+	}
+}
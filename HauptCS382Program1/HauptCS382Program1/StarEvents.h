@@ -0,0 +1,139 @@
+/***********************************************************************/
+/* Filename: StarEvents.h                                              */
+/* Event bus between the simulation and its side effects. The world   */
+/* publishes a fixed-size StarEvent for every collision, freeze,      */
+/* release, stage change and game over, and one at the end of each    */
+/* step; it never beeps, logs or traces itself. Each subscriber has   */
+/* its own single-producer, single-consumer ring and its own thread,  */
+/* which hands the events to the subscriber's handler in batches, so  */
+/* a new consumer is one more Subscribe() call and costs the          */
+/* simulation one ring write per event.                                */
+/*                                                                     */
+/* What happens when a subscriber's ring is full is the subscriber's  */
+/* choice. A lossless subscriber (the log, the trace) makes the       */
+/* publisher wait for room, counted as a stall, so it sees every      */
+/* event. A real-time one (the beeps) has the event dropped for it    */
+/* and counted, so it never slows the simulation. A bus that was      */
+/* never started delivers on the publisher's thread instead, whenever */
+/* a ring fills and on Stop(), and neither waits nor drops.           */
+/* The game's own counters stay in the world: replays and snapshots   */
+/* depend on them.                                                     */
+/***********************************************************************/
+
+#ifndef STAR_EVENTS_H
+#define STAR_EVENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Kinds of published event. //
+enum StarEventType
+{
+	EVENT_COLLISION = 1,              // starA ran into starB; values are their collision counts, count the total. //
+	EVENT_FREEZE,                     // starA frozen; valueA = freeze limit (sec).   //
+	EVENT_UNFREEZE,                   // starA released (click or expiry).            //
+	EVENT_STAGE_CHANGE,               // starA reached stage valueA.                  //
+	EVENT_GAME_OVER,                  // Every star has turned yellow.                //
+	EVENT_STEP_END                    // The step is over; count = collisions so far. //
+};
+
+struct StarEvent
+{
+	uint64_t tick;                    // Simulation tick the event happened on. //
+	int32_t  type;                    // StarEventType. //
+	int32_t  starA;
+	int32_t  starB;                   // -1 when the event involves one star. //
+	int32_t  valueA;
+	int32_t  valueB;
+	uint64_t count;
+};
+
+// Consumes a batch of events, in publication order, on its subscriber's thread. //
+typedef void (*EventHandler)(void *context, const StarEvent *events, int count);
+
+// What a subscriber's full ring does to the publisher. //
+enum EventDelivery
+{
+	DELIVER_LOSSLESS = 0,             // Publisher waits for room.              //
+	DELIVER_DROP_WHEN_FULL            // Event dropped for this subscriber.     //
+};
+
+const int MAX_EVENT_SUBSCRIBERS = 8;
+const int DEFAULT_EVENT_CAPACITY = 1 << 14;           // Events each ring holds by default. //
+
+class StarEventBus
+{
+public:
+	StarEventBus(int capacity = DEFAULT_EVENT_CAPACITY);
+	~StarEventBus();
+
+	bool Subscribe(EventHandler handler, void *context,   // Call before Start(). //
+		EventDelivery delivery = DELIVER_LOSSLESS);
+	void Start();
+	void Stop();
+
+	/* Hand one event to every subscriber (simulation thread only). */
+	void Publish(const StarEvent &event)
+	{
+		for (int s = 0; s < nbrSubscribers; s++)
+			subscribers[s]->Push(event, mask);
+		published++;
+	}
+
+	unsigned long Published() const { return published; }
+	unsigned long Dropped() const;
+	unsigned long Stalls() const;
+
+private:
+	struct Subscriber
+	{
+		EventHandler handler;
+		void *context;
+		EventDelivery delivery;
+		std::unique_ptr<StarEvent[]> ring;
+
+		// The ends live on separate cache lines. The publisher keeps //
+		// its own copy of the tail, so a push reads the consumer's   //
+		// line only when the ring looks full.                        //
+		std::atomic<size_t> head;     // Next slot to fill (publisher). //
+		size_t cachedTail;
+		unsigned long dropped;        // Events that found the ring full (drop when full). //
+		unsigned long stalls;         // Events that waited for room (lossless).           //
+		char headPadding[64];
+		std::atomic<size_t> tail;     // Next slot to consume (subscriber thread). //
+		char tailPadding[64];
+
+		std::thread consumer;
+
+		void Push(const StarEvent &event, size_t mask)
+		{
+			size_t position = head.load(std::memory_order_relaxed);
+			if (position - cachedTail > mask && !MakeRoom(position, mask))
+				return;
+			ring[position & mask] = event;
+			head.store(position + 1, std::memory_order_release);
+		}
+		bool MakeRoom(size_t position, size_t mask);
+		bool Drain(size_t mask);
+	};
+
+	std::unique_ptr<Subscriber> subscribers[MAX_EVENT_SUBSCRIBERS];
+	int    nbrSubscribers;
+	size_t mask;                      // Ring capacity - 1 (capacity is a power of two). //
+	unsigned long published;
+	std::atomic<bool> running;
+
+	void ConsumerLoop(Subscriber *subscriber);
+
+	StarEventBus(const StarEventBus &);
+	StarEventBus &operator=(const StarEventBus &);
+};
+
+// Standard subscribers; the context is the object named. //
+void PlayEvents(void *audio, const StarEvent *events, int count);     // StarAudio: the game's beeps. //
+void LogEvents(void *log, const StarEvent *events, int count);        // StarLog: collision lines.    //
+void TraceEvents(void *trace, const StarEvent *events, int count);    // StarTrace: every record.     //
+
+#endif
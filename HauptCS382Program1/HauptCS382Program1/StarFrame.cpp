@@ -0,0 +1,73 @@
+/***********************************************************************/
+/* Filename: StarFrame.cpp                                             */
+/* Capturing render frames, and handing them over in a triple buffer. */
+/***********************************************************************/
+
+#include "StarFrame.h"
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int FRAME_FRESH = 4;                            // Set on the middle index once published. //
+const int FRAME_INDEX = 3;                            // Mask of the index itself.               //
+
+
+StarFrame::StarFrame()
+{
+	nbrStars = 0;
+	frozenStars = 0;
+	gameSeconds = 0;
+	gameOver = false;
+	tickSeconds = 1.0f / DEFAULT_SIM_HZ;
+	capturedAt = 0.0;
+	lag = 0.0;
+}
+
+/* Copy the render data of the parameterized world, noting the real */
+/* time of the capture and how much of it the world has yet to      */
+/* simulate. Only the first capture of a star count allocates.      */
+void StarFrame::Capture(const StarWorld &world, double captureTime, double lagSeconds)
+{
+	nbrStars = world.nbrStars;
+	x.assign(world.x.begin(), world.x.end());
+	y.assign(world.y.begin(), world.y.end());
+	prevX.assign(world.prevX.begin(), world.prevX.end());
+	prevY.assign(world.prevY.begin(), world.prevY.end());
+	spinCos.assign(world.spinCos.begin(), world.spinCos.end());
+	spinSin.assign(world.spinSin.begin(), world.spinSin.end());
+	pulsation.assign(world.pulsation.begin(), world.pulsation.end());
+	radius.assign(world.radius.begin(), world.radius.end());
+	color.assign(world.color.begin(), world.color.end());
+
+	frozenStars = world.FrozenStars();
+	gameSeconds = world.GAME_SECONDS;
+	gameOver = world.gameOver;
+	tickSeconds = world.tickSeconds;
+	capturedAt = captureTime;
+	lag = lagSeconds;
+}
+
+
+StarFrameBuffer::StarFrameBuffer()
+{
+	back = 0;
+	middle.store(1);
+	front = 2;
+}
+
+/* Make the back frame the newest, and take the frame it replaces as */
+/* the next one to fill.                                             */
+void StarFrameBuffer::Publish()
+{
+	back = middle.exchange(back | FRAME_FRESH, memory_order_acq_rel) & FRAME_INDEX;
+}
+
+/* The newest published frame: swapped in if one arrived since the */
+/* last call, otherwise the one drawn last time.                   */
+const StarFrame &StarFrameBuffer::Latest()
+{
+	if (middle.load(memory_order_relaxed) & FRAME_FRESH)
+		front = middle.exchange(front, memory_order_acq_rel) & FRAME_INDEX;
+	return frames[front];
+}
@@ -0,0 +1,93 @@
+/***********************************************************************/
+/* Filename: StarFrame.h                                               */
+/* What the display needs of the world, copied out of it. The         */
+/* simulation captures a StarFrame after each batch of ticks and      */
+/* publishes it through a StarFrameBuffer; the display always draws   */
+/* the newest complete frame, so drawing one frame overlaps           */
+/* simulating the next and neither side ever waits on the other.      */
+/*                                                                     */
+/* The buffer is a lock-free triple buffer: the simulation fills its  */
+/* back frame and swaps it with the middle one, and the display swaps */
+/* the middle frame for its front one whenever a newer one is there.  */
+/* Published frames are never written again until the display has    */
+/* let them go.                                                        */
+/***********************************************************************/
+
+#ifndef STAR_FRAME_H
+#define STAR_FRAME_H
+
+#include <atomic>
+#include <vector>
+#include "StarWorld.h"
+
+class StarFrame
+{
+public:
+	int nbrStars;
+
+	// Per-star render data, as in the world at capture. //
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> prevX;
+	std::vector<float> prevY;
+	std::vector<float> spinCos;
+	std::vector<float> spinSin;
+	std::vector<float> pulsation;
+	std::vector<float> radius;
+	std::vector<float> color;         // Three floats per star. //
+
+	// For the title bar and the end of the game. //
+	int  frozenStars;
+	int  gameSeconds;
+	bool gameOver;
+
+	// For interpolating between the last two ticks. //
+	float  tickSeconds;
+	double capturedAt;                // Real time of capture (ClockSeconds()). //
+	double lag;                       // Real time not yet simulated at capture. //
+
+	StarFrame();
+
+	void Capture(const StarWorld &world, double captureTime, double lagSeconds);
+
+	/* Fraction of a tick past the previous positions to draw at the */
+	/* parameterized real time: how far the unsimulated time reaches */
+	/* into the next tick, up to a whole tick.                        */
+	float Alpha(double now) const
+	{
+		double alpha = (lag + (now - capturedAt)) / tickSeconds;
+		return alpha < 0.0 ? 0.0f : (alpha > 1.0 ? 1.0f : (float)alpha);
+	}
+
+	/* Position of the parameterized outline vertex of the indexed star, */
+	/* placed as StarWorld::OutlineVertex places it.                     */
+	void OutlineVertex(int index, int vertex, float &vertexX, float &vertexY) const
+	{
+		PlaceOutlineVertex(STAR_OUTLINE, vertex, x[index], y[index], pulsation[index] * radius[index],
+			spinCos[index], spinSin[index], vertexX, vertexY);
+	}
+};
+
+class StarFrameBuffer
+{
+public:
+	StarFrameBuffer();
+
+	// Simulation side. //
+	StarFrame &Back() { return frames[back]; }
+	void Publish();
+
+	// Display side. //
+	const StarFrame &Latest();
+
+private:
+	StarFrame frames[3];
+	int back;                         // Frame being filled (simulation only). //
+	int front;                        // Frame being drawn (display only).     //
+	std::atomic<int> middle;          // Frame in between, plus FRAME_FRESH if unseen. //
+
+	StarFrameBuffer(const StarFrameBuffer &);
+	StarFrameBuffer &operator=(const StarFrameBuffer &);
+};
+
+#endif
@@ -0,0 +1,76 @@
+/***********************************************************************/
+/* Filename: StarGrid.cpp                                              */
+/* Uniform-grid broad phase for star collisions.                      */
+/***********************************************************************/
+
+#include "StarGrid.h"
+#include <cmath>
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int CELLS_PER_STAR = 4;          // Upper bound on grid cells per star. //
+
+
+StarGrid::StarGrid()
+{
+	columns = rows = 1;
+	cellSize = 1.0f;
+	originX = originY = 0.0f;
+	inverseCellSize = 1.0f;
+}
+
+/* Bucket the parameterized star centers and collision reaches into  */
+/* square cells covering a width x height window centered on the     */
+/* origin. Cells are at least minimumCellSize wide, and are enlarged */
+/* if needed so that the grid never has more than CELLS_PER_STAR     */
+/* cells per star.                                                   */
+void StarGrid::Build(const float *x, const float *y, const float *reach, int nbrStars,
+	float width, float height, float minimumCellSize)
+{
+	cellSize = minimumCellSize;
+	double maxCells = (double)CELLS_PER_STAR * (nbrStars > 0 ? nbrStars : 1);
+	if ((double)(width / cellSize) * (height / cellSize) > maxCells)
+		cellSize = (float)sqrt((double)width * height / maxCells);
+
+	columns = (int)ceil(width / cellSize);
+	rows = (int)ceil(height / cellSize);
+	if (columns < 1)
+		columns = 1;
+	if (rows < 1)
+		rows = 1;
+	originX = -width / 2.0f;
+	originY = -height / 2.0f;
+	inverseCellSize = 1.0f / cellSize;
+
+	// Counting sort: tally each cell, prefix-sum the tallies into //
+	// starting offsets, then scatter the star indices.            //
+	int nbrCells = columns * rows;
+	cellStart.assign(nbrCells + 1, 0);
+	starCell.resize(nbrStars);
+	cellStars.resize(nbrStars);
+	for (int i = 0; i < nbrStars; i++)
+	{
+		int cell = Row(y[i]) * columns + Column(x[i]);
+		starCell[i] = cell;
+		cellStart[cell + 1]++;
+	}
+	for (int c = 0; c < nbrCells; c++)
+		cellStart[c + 1] += cellStart[c];
+
+	slotX.resize(nbrStars);
+	slotY.resize(nbrStars);
+	slotReach.resize(nbrStars);
+	starSlot.resize(nbrStars);
+	cellFill.assign(cellStart.begin(), cellStart.end() - 1);
+	for (int i = 0; i < nbrStars; i++)
+	{
+		int slot = cellFill[starCell[i]]++;
+		cellStars[slot] = i;
+		slotX[slot] = x[i];
+		slotY[slot] = y[i];
+		slotReach[slot] = reach[i];
+		starSlot[i] = slot;
+	}
+}
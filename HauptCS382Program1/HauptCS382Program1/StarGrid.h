@@ -0,0 +1,52 @@
+/***********************************************************************/
+/* Filename: StarGrid.h                                                */
+/* Uniform-grid broad phase for star collisions. The grid is rebuilt  */
+/* from scratch each tick with a counting sort, so every cell's stars */
+/* end up contiguous in one index array.                               */
+/***********************************************************************/
+
+#ifndef STAR_GRID_H
+#define STAR_GRID_H
+
+#include <vector>
+
+class StarGrid
+{
+public:
+	int   columns;                    // # cells across the grid. //
+	int   rows;                       // # cells down the grid.   //
+	float cellSize;                   // Width (and height) of one cell. //
+
+	std::vector<int> cellStart;       // Cell c holds slots cellStart[c] .. cellStart[c + 1] - 1. //
+	std::vector<int> cellStars;       // Star index in each slot. //
+	std::vector<float> slotX;         // Star center in each slot, copied so a cell's //
+	std::vector<float> slotY;         // candidates are read from contiguous memory.  //
+	std::vector<float> slotReach;     // Collision reach of the star in each slot.    //
+	std::vector<int> starCell;        // Cell holding each star. //
+	std::vector<int> starSlot;        // Slot holding each star. //
+
+	StarGrid();
+
+	void Build(const float *x, const float *y, const float *reach, int nbrStars,
+		float width, float height, float minimumCellSize);
+
+	/* Column (or row) index of a coordinate, clamped to the grid. */
+	int Column(float x) const
+	{
+		int c = (int)((x - originX) * inverseCellSize);
+		return c < 0 ? 0 : (c >= columns ? columns - 1 : c);
+	}
+	int Row(float y) const
+	{
+		int r = (int)((y - originY) * inverseCellSize);
+		return r < 0 ? 0 : (r >= rows ? rows - 1 : r);
+	}
+
+private:
+	float originX;                    // World coordinates of the grid's lower-left corner. //
+	float originY;
+	float inverseCellSize;
+	std::vector<int> cellFill;        // Scatter cursor per cell, reused between builds. //
+};
+
+#endif
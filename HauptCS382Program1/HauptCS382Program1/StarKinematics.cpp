@@ -0,0 +1,154 @@
+/***********************************************************************/
+/* Filename: StarKinematics.cpp                                        */
+/* Scalar and SSE builds of the kinematics kernel, and the run-time   */
+/* choice between them and the AVX2 build (StarKinematicsAvx2.cpp).   */
+/***********************************************************************/
+
+#include "StarKinematicsKernel.h"
+#include <cstring>			// Header File For strcmp()
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define STAR_KINEMATICS_SSE 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Built in StarKinematicsAvx2.cpp, when the compiler targets AVX2 there. //
+extern const bool KINEMATICS_AVX2_BUILT;
+void RunKinematicsAvx2(const KinematicsStep &step, int first, int last);
+
+
+#ifdef STAR_KINEMATICS_SSE
+// Four stars at a time. //
+struct SseOps
+{
+	typedef __m128  Float;
+	typedef __m128i Int;
+	typedef __m128  Mask;
+	static const int WIDTH = 4;
+
+	static Float Load(const float *p)            { return _mm_loadu_ps(p); }
+	static void  Store(float *p, Float v)        { _mm_storeu_ps(p, v); }
+	static Float Set(float v)                    { return _mm_set1_ps(v); }
+	static Float Add(Float a, Float b)           { return _mm_add_ps(a, b); }
+	static Float Sub(Float a, Float b)           { return _mm_sub_ps(a, b); }
+	static Float Mul(Float a, Float b)           { return _mm_mul_ps(a, b); }
+	static Mask  Greater(Float a, Float b)       { return _mm_cmpgt_ps(a, b); }
+	static Mask  Less(Float a, Float b)          { return _mm_cmplt_ps(a, b); }
+	static Mask  Or(Mask a, Mask b)              { return _mm_or_ps(a, b); }
+	static Float Select(Mask m, Float a, Float b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+	static Mask  Moving(const int *freezeLimit)
+	{
+		__m128i limit = _mm_loadu_si128((const __m128i *)freezeLimit);
+		return _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_set1_epi32(1), limit));
+	}
+	static Int   Round(Float v)                  { return _mm_cvtps_epi32(v); }
+	static Float ToFloat(Int v)                  { return _mm_cvtepi32_ps(v); }
+	static Int   AddInt(Int a, int b)            { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+	static Mask  BitSet(Int v, int bit)
+	{
+		__m128i bits = _mm_set1_epi32(bit);
+		return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(v, bits), bits));
+	}
+};
+#endif
+
+
+/* Name of the parameterized path, as accepted by ParseKinematicsPath. */
+const char *KinematicsPathName(KinematicsPath path)
+{
+	switch (path)
+	{
+	case KINEMATICS_SCALAR: return "scalar";
+	case KINEMATICS_SSE:    return "sse";
+	case KINEMATICS_AVX2:   return "avx2";
+	}
+	return "unknown";
+}
+
+/* Look up a path by name; returns false if the name is unknown. */
+bool ParseKinematicsPath(const char *name, KinematicsPath &path)
+{
+	for (int p = KINEMATICS_SCALAR; p <= KINEMATICS_AVX2; p++)
+	{
+		if (strcmp(name, KinematicsPathName((KinematicsPath)p)) == 0)
+		{
+			path = (KinematicsPath)p;
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Whether the AVX2 build exists and this processor (and operating  */
+/* system, which must save the wider registers) can run it.         */
+static bool CpuHasAvx2()
+{
+	if (!KINEMATICS_AVX2_BUILT)
+		return false;
+#if defined(_MSC_VER) && defined(STAR_KINEMATICS_SSE)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	__cpuid(info, 1);
+	bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+		(_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	return osSavesAvx && (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(STAR_KINEMATICS_SSE)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") != 0;
+#else
+	return false;
+#endif
+}
+
+/* Whether the parameterized path can run on this machine. */
+bool KinematicsPathSupported(KinematicsPath path)
+{
+	switch (path)
+	{
+	case KINEMATICS_SCALAR: return true;
+#ifdef STAR_KINEMATICS_SSE
+	case KINEMATICS_SSE:    return true;
+#else
+	case KINEMATICS_SSE:    return false;
+#endif
+	case KINEMATICS_AVX2:   return CpuHasAvx2();
+	}
+	return false;
+}
+
+/* The widest path this machine supports; checked once. */
+KinematicsPath BestKinematicsPath()
+{
+	static const KinematicsPath best =
+		KinematicsPathSupported(KINEMATICS_AVX2) ? KINEMATICS_AVX2 :
+		KinematicsPathSupported(KINEMATICS_SSE) ? KINEMATICS_SSE : KINEMATICS_SCALAR;
+	return best;
+}
+
+/* Advance stars first through last - 1 by one tick along the       */
+/* parameterized path. The stars left over after the last full      */
+/* vector are finished by the scalar kernel, which computes exactly */
+/* the same values.                                                 */
+void RunKinematics(KinematicsPath path, const KinematicsStep &step, int first, int last)
+{
+	int vectorEnd = first;
+	if (path == KINEMATICS_AVX2 && BestKinematicsPath() == KINEMATICS_AVX2)
+	{
+		vectorEnd = first + (last - first) / 8 * 8;
+		RunKinematicsAvx2(step, first, vectorEnd);
+	}
+#ifdef STAR_KINEMATICS_SSE
+	else if (path != KINEMATICS_SCALAR)
+	{
+		vectorEnd = first + (last - first) / SseOps::WIDTH * SseOps::WIDTH;
+		KinematicsKernel<SseOps>(step, first, vectorEnd);
+	}
+#endif
+	KinematicsKernel<ScalarOps>(step, vectorEnd, last);
+}
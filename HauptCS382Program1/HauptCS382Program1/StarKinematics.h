@@ -0,0 +1,51 @@
+/***********************************************************************/
+/* Filename: StarKinematics.h                                          */
+/* The per-tick star update (pulsation bounce, motion, spin wrap, the */
+/* spin's sin/cos and reflection off of the window borders) as one    */
+/* kernel over the structure-of-arrays star data. The same kernel is  */
+/* built for scalar code, SSE (4 stars at a time) and AVX2 (8 stars   */
+/* at a time); frozen stars are masked out rather than branched on.   */
+/* Every path performs the same float operations in the same order,  */
+/* so they produce identical results and a run does not depend on the */
+/* machine's instruction set.                                         */
+/***********************************************************************/
+
+#ifndef STAR_KINEMATICS_H
+#define STAR_KINEMATICS_H
+
+// Instruction sets the kernel is built for. //
+enum KinematicsPath
+{
+	KINEMATICS_SCALAR,
+	KINEMATICS_SSE,
+	KINEMATICS_AVX2
+};
+const char *KinematicsPathName(KinematicsPath path);
+bool ParseKinematicsPath(const char *name, KinematicsPath &path);
+bool KinematicsPathSupported(KinematicsPath path);
+KinematicsPath BestKinematicsPath();
+
+// The arrays and parameters of one tick. //
+struct KinematicsStep
+{
+	float *x;
+	float *y;
+	float *xInc;
+	float *yInc;
+	float *spin;
+	const float *spinInc;
+	float *spinCos;
+	float *spinSin;
+	float *pulsation;
+	float *pulsationInc;
+	const float *radius;
+	const int *freezeLimit;           // Stars with a positive limit are frozen. //
+
+	float tickSeconds;
+	float halfWidth;                  // Window extents from the center. //
+	float halfHeight;
+};
+
+void RunKinematics(KinematicsPath path, const KinematicsStep &step, int first, int last);
+
+#endif
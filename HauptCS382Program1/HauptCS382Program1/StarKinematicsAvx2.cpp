@@ -0,0 +1,62 @@
+/***********************************************************************/
+/* Filename: StarKinematicsAvx2.cpp                                    */
+/* AVX2 build of the kinematics kernel, eight stars at a time. This   */
+/* file alone is compiled for AVX2 (-mavx2, /arch:AVX2), and is only  */
+/* called once the processor has been checked for it. FMA is left     */
+/* off on purpose: fused multiply-adds round differently, and every   */
+/* path must produce the same results.                                */
+/***********************************************************************/
+
+#include "StarKinematicsKernel.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+extern const bool KINEMATICS_AVX2_BUILT = true;
+
+struct Avx2Ops
+{
+	typedef __m256  Float;
+	typedef __m256i Int;
+	typedef __m256  Mask;
+	static const int WIDTH = 8;
+
+	static Float Load(const float *p)            { return _mm256_loadu_ps(p); }
+	static void  Store(float *p, Float v)        { _mm256_storeu_ps(p, v); }
+	static Float Set(float v)                    { return _mm256_set1_ps(v); }
+	static Float Add(Float a, Float b)           { return _mm256_add_ps(a, b); }
+	static Float Sub(Float a, Float b)           { return _mm256_sub_ps(a, b); }
+	static Float Mul(Float a, Float b)           { return _mm256_mul_ps(a, b); }
+	static Mask  Greater(Float a, Float b)       { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	static Mask  Less(Float a, Float b)          { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	static Mask  Or(Mask a, Mask b)              { return _mm256_or_ps(a, b); }
+	static Float Select(Mask m, Float a, Float b) { return _mm256_blendv_ps(b, a, m); }
+	static Mask  Moving(const int *freezeLimit)
+	{
+		__m256i limit = _mm256_loadu_si256((const __m256i *)freezeLimit);
+		return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(1), limit));
+	}
+	static Int   Round(Float v)                  { return _mm256_cvtps_epi32(v); }
+	static Float ToFloat(Int v)                  { return _mm256_cvtepi32_ps(v); }
+	static Int   AddInt(Int a, int b)            { return _mm256_add_epi32(a, _mm256_set1_epi32(b)); }
+	static Mask  BitSet(Int v, int bit)
+	{
+		__m256i bits = _mm256_set1_epi32(bit);
+		return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(v, bits), bits));
+	}
+};
+
+void RunKinematicsAvx2(const KinematicsStep &step, int first, int last)
+{
+	KinematicsKernel<Avx2Ops>(step, first, last);
+}
+
+#else
+// The compiler was not asked for AVX2; the dispatcher never calls this. //
+extern const bool KINEMATICS_AVX2_BUILT = false;
+
+void RunKinematicsAvx2(const KinematicsStep &step, int first, int last)
+{
+	KinematicsKernel<ScalarOps>(step, first, last);
+}
+#endif
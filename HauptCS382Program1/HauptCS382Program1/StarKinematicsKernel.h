@@ -0,0 +1,169 @@
+/***********************************************************************/
+/* Filename: StarKinematicsKernel.h                                    */
+/* The kinematics kernel, written once against a small set of vector  */
+/* operations (Ops) and instantiated for each instruction set. Only   */
+/* the StarKinematics sources include this file.                      */
+/***********************************************************************/
+
+#ifndef STAR_KINEMATICS_KERNEL_H
+#define STAR_KINEMATICS_KERNEL_H
+
+#include <cmath>
+#include "StarKinematics.h"
+#include "StarWorld.h"
+
+// Spin wraps back by a full turn once it passes one, as it always has. //
+const float FULL_TURN = 360 * PI_OVER_180;
+
+// pi/2 split into three parts, so that subtracting multiples of it //
+// loses no precision (Cody-Waite reduction).                       //
+const float HALF_PI_1 = 1.5703125f;
+const float HALF_PI_2 = 4.837512969970703125e-4f;
+const float HALF_PI_3 = 7.54978995489188216e-8f;
+const float TWO_OVER_PI = 0.636619772367581343f;
+
+// Single-precision minimax polynomials on [-pi/4, pi/4] (Cephes). //
+const float SINE_C1 = -1.6666654611e-1f;
+const float SINE_C2 = 8.3321608736e-3f;
+const float SINE_C3 = -1.9515295891e-4f;
+const float COSINE_C1 = 4.166664568298827e-2f;
+const float COSINE_C2 = -1.388731625493765e-3f;
+const float COSINE_C3 = 2.443315711809948e-5f;
+
+
+// One star at a time; also finishes the tail of the vector paths. //
+struct ScalarOps
+{
+	typedef float Float;
+	typedef int   Int;
+	typedef bool  Mask;
+	static const int WIDTH = 1;
+
+	static Float Load(const float *p)            { return *p; }
+	static void  Store(float *p, Float v)        { *p = v; }
+	static Float Set(float v)                    { return v; }
+	static Float Add(Float a, Float b)           { return a + b; }
+	static Float Sub(Float a, Float b)           { return a - b; }
+	static Float Mul(Float a, Float b)           { return a * b; }
+	static Mask  Greater(Float a, Float b)       { return a > b; }
+	static Mask  Less(Float a, Float b)          { return a < b; }
+	static Mask  Or(Mask a, Mask b)              { return a || b; }
+	static Float Select(Mask m, Float a, Float b) { return m ? a : b; }
+	static Mask  Moving(const int *freezeLimit)  { return *freezeLimit <= 0; }
+	static Int   Round(Float v)                  { return (int)lrintf(v); }
+	static Float ToFloat(Int v)                  { return (float)v; }
+	static Int   AddInt(Int a, int b)            { return a + b; }
+	static Mask  BitSet(Int v, int bit)          { return (v & bit) != 0; }
+};
+
+
+/* Sine and cosine of the parameterized angles: reduce to [-pi/4, pi/4] */
+/* around the nearest multiple of pi/2, evaluate both polynomials, and  */
+/* swap or negate them by quadrant.                                     */
+template <class Ops>
+inline void SinCos(typename Ops::Float angle, typename Ops::Float &sine, typename Ops::Float &cosine)
+{
+	typedef typename Ops::Float Float;
+	typename Ops::Int quadrant = Ops::Round(Ops::Mul(angle, Ops::Set(TWO_OVER_PI)));
+	Float multiple = Ops::ToFloat(quadrant);
+	Float r = Ops::Sub(angle, Ops::Mul(multiple, Ops::Set(HALF_PI_1)));
+	r = Ops::Sub(r, Ops::Mul(multiple, Ops::Set(HALF_PI_2)));
+	r = Ops::Sub(r, Ops::Mul(multiple, Ops::Set(HALF_PI_3)));
+	Float z = Ops::Mul(r, r);
+
+	Float s = Ops::Add(Ops::Mul(Ops::Set(SINE_C3), z), Ops::Set(SINE_C2));
+	s = Ops::Add(Ops::Mul(s, z), Ops::Set(SINE_C1));
+	s = Ops::Add(Ops::Mul(Ops::Mul(s, z), r), r);
+
+	Float c = Ops::Add(Ops::Mul(Ops::Set(COSINE_C3), z), Ops::Set(COSINE_C2));
+	c = Ops::Add(Ops::Mul(c, z), Ops::Set(COSINE_C1));
+	c = Ops::Add(Ops::Sub(Ops::Mul(Ops::Mul(c, z), z), Ops::Mul(Ops::Set(0.5f), z)), Ops::Set(1.0f));
+
+	typename Ops::Mask swap = Ops::BitSet(quadrant, 1);
+	Float sineValue = Ops::Select(swap, c, s);
+	Float cosineValue = Ops::Select(swap, s, c);
+	sine = Ops::Select(Ops::BitSet(quadrant, 2), Ops::Mul(sineValue, Ops::Set(-1.0f)), sineValue);
+	cosine = Ops::Select(Ops::BitSet(Ops::AddInt(quadrant, 1), 2), Ops::Mul(cosineValue, Ops::Set(-1.0f)), cosineValue);
+}
+
+/* Advance stars first through last - 1 (a multiple of Ops::WIDTH) by */
+/* one tick. Pulsation bounces between 1 and PULSATION_FACTOR for     */
+/* every star. Stars that are not frozen also move and spin; a star   */
+/* with a tip past a window border has that velocity component        */
+/* reversed and is pulled back to its radius inside the border.       */
+template <class Ops>
+void KinematicsKernel(const KinematicsStep &step, int first, int last)
+{
+	typedef typename Ops::Float Float;
+	typedef typename Ops::Mask  Mask;
+
+	const Float dt = Ops::Set(step.tickSeconds);
+	const Float minusOne = Ops::Set(-1.0f);
+	const Float one = Ops::Set(1.0f);
+	const Float maxPulsation = Ops::Set(PULSATION_FACTOR);
+	const Float fullTurn = Ops::Set(FULL_TURN);
+	const Float halfWidth = Ops::Set(step.halfWidth);
+	const Float halfHeight = Ops::Set(step.halfHeight);
+	const Float minusHalfWidth = Ops::Set(-step.halfWidth);
+	const Float minusHalfHeight = Ops::Set(-step.halfHeight);
+
+	for (int i = first; i < last; i += Ops::WIDTH)
+	{
+		// Pulsation, bounced off of both limits. //
+		Float pulsation = Ops::Add(Ops::Load(step.pulsation + i), Ops::Mul(Ops::Load(step.pulsationInc + i), dt));
+		Float pulsationInc = Ops::Load(step.pulsationInc + i);
+		Mask over = Ops::Greater(pulsation, maxPulsation);
+		Mask under = Ops::Less(pulsation, one);
+		pulsationInc = Ops::Select(Ops::Or(over, under), Ops::Mul(pulsationInc, minusOne), pulsationInc);
+		pulsation = Ops::Select(over, maxPulsation, Ops::Select(under, one, pulsation));
+		Ops::Store(step.pulsation + i, pulsation);
+		Ops::Store(step.pulsationInc + i, pulsationInc);
+
+		// Motion and spin, for the stars that are not frozen. //
+		Mask moving = Ops::Moving(step.freezeLimit + i);
+		Float x0 = Ops::Load(step.x + i);
+		Float y0 = Ops::Load(step.y + i);
+		Float xInc0 = Ops::Load(step.xInc + i);
+		Float yInc0 = Ops::Load(step.yInc + i);
+		Float spin0 = Ops::Load(step.spin + i);
+		Float x = Ops::Add(x0, Ops::Mul(xInc0, dt));
+		Float y = Ops::Add(y0, Ops::Mul(yInc0, dt));
+		Float spin = Ops::Add(spin0, Ops::Mul(Ops::Load(step.spinInc + i), dt));
+		spin = Ops::Select(Ops::Greater(spin, fullTurn), Ops::Sub(spin, fullTurn), spin);
+		Float spinSin, spinCos;
+		SinCos<Ops>(spin, spinSin, spinCos);
+
+		// Which borders the star's tips cross. //
+		Float radius = Ops::Load(step.radius + i);
+		Float tipRadius = Ops::Mul(pulsation, radius);
+		Mask tooRight = Ops::Less(one, one);
+		Mask tooLeft = tooRight, tooHigh = tooRight, tooLow = tooRight;
+		for (int j = 0; j < NBR_STAR_TIPS; j++)
+		{
+			Float unitX = Ops::Set(STAR_OUTLINE.x[2 * j]);
+			Float unitY = Ops::Set(STAR_OUTLINE.y[2 * j]);
+			Float tipX = Ops::Add(x, Ops::Mul(tipRadius, Ops::Sub(Ops::Mul(unitX, spinCos), Ops::Mul(unitY, spinSin))));
+			Float tipY = Ops::Add(y, Ops::Mul(tipRadius, Ops::Add(Ops::Mul(unitX, spinSin), Ops::Mul(unitY, spinCos))));
+			tooRight = Ops::Or(tooRight, Ops::Greater(tipX, halfWidth));
+			tooLeft = Ops::Or(tooLeft, Ops::Less(tipX, minusHalfWidth));
+			tooHigh = Ops::Or(tooHigh, Ops::Greater(tipY, halfHeight));
+			tooLow = Ops::Or(tooLow, Ops::Less(tipY, minusHalfHeight));
+		}
+
+		// Reflect off of the crossed borders. //
+		Float xInc = Ops::Select(Ops::Or(tooRight, tooLeft), Ops::Mul(xInc0, minusOne), xInc0);
+		Float yInc = Ops::Select(Ops::Or(tooHigh, tooLow), Ops::Mul(yInc0, minusOne), yInc0);
+		x = Ops::Select(tooRight, Ops::Sub(halfWidth, radius), Ops::Select(tooLeft, Ops::Add(minusHalfWidth, radius), x));
+		y = Ops::Select(tooHigh, Ops::Sub(halfHeight, radius), Ops::Select(tooLow, Ops::Add(minusHalfHeight, radius), y));
+
+		Ops::Store(step.x + i, Ops::Select(moving, x, x0));
+		Ops::Store(step.y + i, Ops::Select(moving, y, y0));
+		Ops::Store(step.xInc + i, Ops::Select(moving, xInc, xInc0));
+		Ops::Store(step.yInc + i, Ops::Select(moving, yInc, yInc0));
+		Ops::Store(step.spin + i, Ops::Select(moving, spin, spin0));
+		Ops::Store(step.spinCos + i, Ops::Select(moving, spinCos, Ops::Load(step.spinCos + i)));
+		Ops::Store(step.spinSin + i, Ops::Select(moving, spinSin, Ops::Load(step.spinSin + i)));
+	}
+}
+
+#endif
@@ -0,0 +1,219 @@
+/***********************************************************************/
+/* Filename: StarLog.cpp                                               */
+/* Asynchronous debug log: lock-free ring plus background writer.     */
+/***********************************************************************/
+
+#include "StarLog.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int WRITER_IDLE_MSEC = 5;                       // Writer nap when the ring is empty. //
+const char *LOG_CATEGORY_NAME[NBR_LOG_CATEGORIES] = { "collision", "display", "mouse" };
+const char *LOG_LEVEL_NAME[] = { "off", "error", "info", "debug" };
+
+
+/* Set up an idle log whose ring holds the parameterized number of */
+/* records, rounded up to a power of two. Every category is off.   */
+StarLog::StarLog(int capacity)
+{
+	size_t size = 1;
+	while (size < (size_t)capacity)
+		size <<= 1;
+	ring.reset(new Record[size]);
+	for (size_t i = 0; i < size; i++)
+		ring[i].sequence.store(i, memory_order_relaxed);
+	mask = size - 1;
+	head.store(0);
+	tail.store(0);
+
+	for (int c = 0; c < NBR_LOG_CATEGORIES; c++)
+	{
+		levels[c].store(LOG_OFF);
+		files[c] = NULL;
+	}
+	dropped.store(0);
+	lossless.store(false);
+	running.store(false);
+}
+
+/* Flush whatever is still queued and close the files. */
+StarLog::~StarLog()
+{
+	Stop();
+	for (int c = 0; c < NBR_LOG_CATEGORIES; c++)
+		if (files[c] != NULL)
+			fclose(files[c]);
+}
+
+/* Append the category's records to the named file. Call before Start(). */
+bool StarLog::Open(LogCategory category, const char *fileName)
+{
+	if (files[category] != NULL)
+		fclose(files[category]);
+#ifdef _MSC_VER
+	if (fopen_s(&files[category], fileName, "a") != 0)
+		files[category] = NULL;
+#else
+	files[category] = fopen(fileName, "a");
+#endif
+	return files[category] != NULL;
+}
+
+void StarLog::SetLevel(LogCategory category, LogLevel level)
+{
+	levels[category].store(level, memory_order_relaxed);
+}
+
+/* Apply a comma-separated list of category=level settings, such as */
+/* "collision=info,display=off"; "all" names every category. Returns */
+/* false (after applying the valid settings) if any entry is bad.    */
+bool StarLog::Configure(const char *spec)
+{
+	bool valid = true;
+	while (*spec != '\0')
+	{
+		const char *end = strchr(spec, ',');
+		size_t length = end != NULL ? (size_t)(end - spec) : strlen(spec);
+		const char *equals = (const char *)memchr(spec, '=', length);
+
+		int level = -1;
+		if (equals != NULL)
+			for (int l = LOG_OFF; l <= LOG_DEBUG; l++)
+				if (strlen(LOG_LEVEL_NAME[l]) == length - (equals + 1 - spec) &&
+					strncmp(equals + 1, LOG_LEVEL_NAME[l], length - (equals + 1 - spec)) == 0)
+					level = l;
+
+		bool matched = false;
+		if (level >= 0)
+			for (int c = 0; c < NBR_LOG_CATEGORIES; c++)
+			{
+				size_t nameLength = equals - spec;
+				if ((nameLength == 3 && strncmp(spec, "all", 3) == 0) ||
+					(strlen(LOG_CATEGORY_NAME[c]) == nameLength && strncmp(spec, LOG_CATEGORY_NAME[c], nameLength) == 0))
+				{
+					SetLevel((LogCategory)c, (LogLevel)level);
+					matched = true;
+				}
+			}
+		if (!matched)
+			valid = false;
+
+		spec += length;
+		if (*spec == ',')
+			spec++;
+	}
+	return valid;
+}
+
+/* Launch the background writer. */
+void StarLog::Start()
+{
+	if (running.exchange(true))
+		return;
+	writer = thread(&StarLog::WriterLoop, this);
+}
+
+/* Stop the background writer after it has drained the ring. */
+void StarLog::Stop()
+{
+	if (!running.exchange(false))
+		return;
+	writer.join();
+	if (dropped.load() > 0)
+		fprintf(stderr, "log: %lu records dropped (ring full)\n", dropped.load());
+}
+
+/* Format a line into the next free ring slot. If the writer has     */
+/* fallen a whole ring behind, the line is dropped, or, for a        */
+/* lossless log whose writer is running, written once a slot frees.  */
+void StarLog::Write(LogCategory category, LogLevel level, const char *format, ...)
+{
+	if (files[category] == NULL)
+		return;
+
+	Record *record;
+	size_t position = head.load(memory_order_relaxed);
+	for (;;)
+	{
+		record = &ring[position & mask];
+		size_t sequence = record->sequence.load(memory_order_acquire);
+		intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+		if (difference == 0)
+		{
+			if (head.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+				break;
+		}
+		else if (difference < 0)
+		{
+			if (!lossless.load(memory_order_relaxed) || !running.load(memory_order_relaxed))
+			{
+				dropped.fetch_add(1, memory_order_relaxed);
+				return;
+			}
+			this_thread::yield();
+			position = head.load(memory_order_relaxed);
+		}
+		else
+			position = head.load(memory_order_relaxed);
+	}
+
+	record->category = (short)category;
+	record->level = (short)level;
+	va_list arguments;
+	va_start(arguments, format);
+	vsnprintf(record->text, LOG_TEXT_SIZE, format, arguments);
+	va_end(arguments);
+	record->sequence.store(position + 1, memory_order_release);
+}
+
+/* Take the oldest complete record off the ring, if there is one. */
+/* Only the writer thread pops.                                   */
+bool StarLog::Pop(short &category, char *text)
+{
+	size_t position = tail.load(memory_order_relaxed);
+	Record *record = &ring[position & mask];
+	if (record->sequence.load(memory_order_acquire) != position + 1)
+		return false;
+
+	category = record->category;
+	memcpy(text, record->text, LOG_TEXT_SIZE);
+	record->sequence.store(position + mask + 1, memory_order_release);
+	tail.store(position + 1, memory_order_relaxed);
+	return true;
+}
+
+/* Write out every queued record. */
+void StarLog::Drain()
+{
+	short category;
+	char text[LOG_TEXT_SIZE];
+	bool wrote = false;
+	while (Pop(category, text))
+	{
+		fputs(text, files[category]);
+		fputc('\n', files[category]);
+		wrote = true;
+	}
+	if (wrote)
+		for (int c = 0; c < NBR_LOG_CATEGORIES; c++)
+			if (files[c] != NULL)
+				fflush(files[c]);
+}
+
+/* Background writer: drain, nap while idle, and drain once more */
+/* after being told to stop.                                     */
+void StarLog::WriterLoop()
+{
+	while (running.load())
+	{
+		Drain();
+		this_thread::sleep_for(chrono::milliseconds(WRITER_IDLE_MSEC));
+	}
+	Drain();
+}
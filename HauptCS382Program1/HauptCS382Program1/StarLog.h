@@ -0,0 +1,95 @@
+/***********************************************************************/
+/* Filename: StarLog.h                                                 */
+/* Asynchronous debug log. Callers format a line into a fixed-size    */
+/* record and push it onto a lock-free ring; a background thread pops */
+/* records and appends them to one file per category. A full ring     */
+/* drops the record rather than making the caller wait, unless the    */
+/* log is lossless, and the STAR_LOG macro skips the formatting       */
+/* entirely for disabled levels.                                      */
+/***********************************************************************/
+
+#ifndef STAR_LOG_H
+#define STAR_LOG_H
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// Subsystems that log, each to its own file. //
+enum LogCategory
+{
+	LOG_COLLISION,                    // Collision detection.       //
+	LOG_DISPLAY,                      // Per-star collision passes. //
+	LOG_MOUSE,                        // Freeze clicks.             //
+	NBR_LOG_CATEGORIES
+};
+
+// Verbosity; a category logs records at or below its level. //
+enum LogLevel
+{
+	LOG_OFF,
+	LOG_ERROR,
+	LOG_INFO,
+	LOG_DEBUG
+};
+
+const int LOG_TEXT_SIZE = 116;                       // Bytes of text per record.         //
+const int DEFAULT_LOG_CAPACITY = 1 << 16;            // Records the ring holds by default. //
+
+/* Log a printf-style line if the category's level allows it. The */
+/* arguments are not evaluated at all when it does not.           */
+#define STAR_LOG(log, category, level, ...) \
+	do { if ((log) != NULL && (log)->Enabled(category, level)) (log)->Write(category, level, __VA_ARGS__); } while (0)
+
+class StarLog
+{
+public:
+	StarLog(int capacity = DEFAULT_LOG_CAPACITY);
+	~StarLog();
+
+	bool Open(LogCategory category, const char *fileName);
+	void SetLevel(LogCategory category, LogLevel level);
+	bool Configure(const char *spec);
+	void SetLossless(bool wait) { lossless.store(wait); }    // Wait for room instead of dropping. //
+	void Start();
+	void Stop();
+
+	bool Enabled(LogCategory category, LogLevel level) const
+	{
+		return level != LOG_OFF && level <= levels[category].load(std::memory_order_relaxed);
+	}
+	void Write(LogCategory category, LogLevel level, const char *format, ...);
+	unsigned long Dropped() const { return dropped.load(); }
+
+private:
+	struct Record
+	{
+		std::atomic<size_t> sequence;     // Ring slot state (Vyukov bounded queue). //
+		short category;
+		short level;
+		char  text[LOG_TEXT_SIZE];
+	};
+
+	std::unique_ptr<Record[]> ring;
+	size_t mask;                          // Ring capacity - 1 (capacity is a power of two). //
+	std::atomic<size_t> head;             // Next slot to fill.  //
+	std::atomic<size_t> tail;             // Next slot to drain. //
+
+	std::atomic<int> levels[NBR_LOG_CATEGORIES];
+	FILE *files[NBR_LOG_CATEGORIES];
+	std::atomic<unsigned long> dropped;   // Records lost to a full ring. //
+	std::atomic<bool> lossless;           // Writers wait for the writer thread. //
+
+	std::thread writer;
+	std::atomic<bool> running;
+
+	bool Pop(short &category, char *text);
+	void Drain();
+	void WriterLoop();
+
+	StarLog(const StarLog &);
+	StarLog &operator=(const StarLog &);
+};
+
+#endif
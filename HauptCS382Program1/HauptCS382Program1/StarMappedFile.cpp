@@ -0,0 +1,104 @@
+/***********************************************************************/
+/* Filename: StarMappedFile.cpp                                        */
+/* Read-only file mapping (MapViewOfFile on Windows, mmap elsewhere). */
+/***********************************************************************/
+
+#include "StarMappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+StarMappedFile::StarMappedFile()
+{
+	data = NULL;
+	size = 0;
+#ifdef _WIN32
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = NULL;
+#else
+	descriptor = -1;
+#endif
+}
+
+StarMappedFile::~StarMappedFile()
+{
+	Close();
+}
+
+/* Map the named file. An empty file opens successfully with no data. */
+bool StarMappedFile::Open(const char *fileName)
+{
+	Close();
+#ifdef _WIN32
+	fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)fileSize.QuadPart;
+	if (size == 0)
+		return true;
+	mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappingHandle != NULL)
+		data = (const unsigned char *)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+	descriptor = open(fileName, O_RDONLY);
+	if (descriptor < 0)
+		return false;
+	struct stat status;
+	if (fstat(descriptor, &status) != 0)
+	{
+		Close();
+		return false;
+	}
+	size = (size_t)status.st_size;
+	if (size == 0)
+		return true;
+	void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (mapping != MAP_FAILED)
+	{
+		data = (const unsigned char *)mapping;
+		madvise(mapping, size, MADV_SEQUENTIAL);
+	}
+#endif
+	if (data == NULL)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void StarMappedFile::Close()
+{
+#ifdef _WIN32
+	if (data != NULL)
+		UnmapViewOfFile(data);
+	if (mappingHandle != NULL)
+		CloseHandle(mappingHandle);
+	if (fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = NULL;
+#else
+	if (data != NULL)
+		munmap((void *)data, size);
+	if (descriptor >= 0)
+		close(descriptor);
+	descriptor = -1;
+#endif
+	data = NULL;
+	size = 0;
+}
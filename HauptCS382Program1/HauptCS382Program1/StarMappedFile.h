@@ -0,0 +1,38 @@
+/***********************************************************************/
+/* Filename: StarMappedFile.h                                          */
+/* Read-only memory mapping of a whole file, so tools can walk large  */
+/* binary files in place instead of reading them into buffers.        */
+/***********************************************************************/
+
+#ifndef STAR_MAPPED_FILE_H
+#define STAR_MAPPED_FILE_H
+
+#include <cstddef>
+
+class StarMappedFile
+{
+public:
+	StarMappedFile();
+	~StarMappedFile();
+
+	bool Open(const char *fileName);
+	void Close();
+
+	const unsigned char *Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+	const unsigned char *data;        // Start of the mapping; NULL when closed or empty. //
+	size_t size;                      // Bytes mapped.                                     //
+#ifdef _WIN32
+	void *fileHandle;
+	void *mappingHandle;
+#else
+	int descriptor;
+#endif
+
+	StarMappedFile(const StarMappedFile &);
+	StarMappedFile &operator=(const StarMappedFile &);
+};
+
+#endif
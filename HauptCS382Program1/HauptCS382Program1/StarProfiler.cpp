@@ -0,0 +1,191 @@
+/***********************************************************************/
+/* Filename: StarProfiler.cpp                                          */
+/* Per-phase frame timing and its histograms.                         */
+/***********************************************************************/
+
+#include "StarProfiler.h"
+#include <cstring>			// Header File For memset()
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+using namespace std;
+
+
+/* Name of the parameterized phase, as reported. */
+const char *ProfilePhaseName(ProfilePhase phase)
+{
+	switch (phase)
+	{
+	case PHASE_MOTION:              return "motion";
+	case PHASE_THAW:                return "thaw";
+	case PHASE_BROAD_PHASE:         return "broad phase";
+	case PHASE_COLLISION_DETECTION: return "collision detection";
+	case PHASE_COLLISION_EFFECTS:   return "collision effects";
+	case PHASE_TITLE:               return "title update";
+	case PHASE_DRAW:                return "draw submission";
+	case PHASE_SWAP:                return "buffer swap";
+	case NBR_PROFILE_PHASES:        break;
+	}
+	return "unknown";
+}
+
+/* Position of the highest set bit of the parameterized nonzero value. */
+static int HighestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long bit;
+	_BitScanReverse64(&bit, value);
+	return (int)bit;
+#else
+	return 63 - __builtin_clzll(value);
+#endif
+}
+
+/* Bucket holding the parameterized value: the value itself while it */
+/* is small, then its power of two and its next HISTOGRAM_SUB_BITS   */
+/* bits.                                                             */
+static int BucketOf(int64_t value)
+{
+	if (value < HISTOGRAM_BUCKETS)
+		return value < 0 ? 0 : (int)value;
+	int bit = HighestBit((uint64_t)value);
+	int shift = bit - HISTOGRAM_SUB_BITS;
+	int sub = (int)(value >> shift) - HISTOGRAM_BUCKETS / 2;
+	return HISTOGRAM_BUCKETS + (bit - HISTOGRAM_SUB_BITS - 1) * (HISTOGRAM_BUCKETS / 2) + sub;
+}
+
+/* Largest value that falls in the parameterized bucket. */
+static int64_t BucketTop(int bucket)
+{
+	if (bucket < HISTOGRAM_BUCKETS)
+		return bucket;
+	int octave = (bucket - HISTOGRAM_BUCKETS) / (HISTOGRAM_BUCKETS / 2);
+	int sub = (bucket - HISTOGRAM_BUCKETS) % (HISTOGRAM_BUCKETS / 2);
+	int shift = octave + 1;
+	return ((int64_t)(HISTOGRAM_BUCKETS / 2 + sub + 1) << shift) - 1;
+}
+
+
+StarHistogram::StarHistogram()
+{
+	Reset();
+}
+
+/* Forget every recorded value. */
+void StarHistogram::Reset()
+{
+	memset(buckets, 0, sizeof(buckets));
+	count = 0;
+	max = 0;
+}
+
+/* Add the parameterized value; negative values count as zero. */
+void StarHistogram::Record(int64_t value)
+{
+	buckets[BucketOf(value)]++;
+	count++;
+	if (value > max)
+		max = value;
+}
+
+/* Value at or below which the parameterized percentage of the   */
+/* recorded values fall, rounded up to its bucket's largest value */
+/* but never past the largest value recorded. Zero if empty.      */
+int64_t StarHistogram::Percentile(double percent) const
+{
+	if (count == 0)
+		return 0;
+	uint64_t rank = (uint64_t)(percent / 100.0 * count + 0.999999);
+	if (rank < 1)
+		rank = 1;
+	if (rank > count)
+		rank = count;
+	uint64_t seen = 0;
+	for (int b = 0; b < NBR_HISTOGRAM_BUCKETS; b++)
+	{
+		seen += buckets[b];
+		if (seen >= rank)
+			return BucketTop(b) < max ? BucketTop(b) : max;
+	}
+	return max;
+}
+
+
+StarProfiler::StarProfiler()
+{
+	Reset();
+}
+
+/* Drop every histogram and the frame in progress. */
+void StarProfiler::Reset()
+{
+	for (int p = 0; p < NBR_PROFILE_PHASES; p++)
+	{
+		phases[p].Reset();
+		frameNanoseconds[p] = 0;
+		ran[p] = false;
+	}
+	frames.Reset();
+	depth = 0;
+	mark = 0;
+}
+
+/* Start timing the parameterized phase, pausing the one it is nested in. */
+void StarProfiler::Begin(ProfilePhase phase)
+{
+	int64_t now = ClockNanoseconds();
+	if (depth > 0)
+		frameNanoseconds[stack[depth - 1]] += now - mark;
+	if (depth < MAX_PROFILE_DEPTH)
+		stack[depth] = phase;
+	depth++;
+	ran[phase] = true;
+	mark = now;
+}
+
+/* Stop timing the innermost phase and resume the one it was nested in. */
+void StarProfiler::End()
+{
+	int64_t now = ClockNanoseconds();
+	depth--;
+	if (depth < MAX_PROFILE_DEPTH)
+		frameNanoseconds[stack[depth]] += now - mark;
+	mark = now;
+}
+
+/* Record the frame's time in each phase that ran during it, and the */
+/* frame's total, then start a new frame.                            */
+void StarProfiler::EndFrame()
+{
+	int64_t total = 0;
+	bool any = false;
+	for (int p = 0; p < NBR_PROFILE_PHASES; p++)
+	{
+		if (!ran[p])
+			continue;
+		phases[p].Record(frameNanoseconds[p]);
+		total += frameNanoseconds[p];
+		any = true;
+		frameNanoseconds[p] = 0;
+		ran[p] = false;
+	}
+	if (any)
+		frames.Record(total);
+}
+
+/* Print each phase's frame count and its median, 99th percentile and */
+/* largest time per frame, in microseconds.                           */
+void StarProfiler::Report(FILE *out) const
+{
+	fprintf(out, "%-20s %10s %10s %10s %10s\n", "phase", "frames", "p50 (us)", "p99 (us)", "max (us)");
+	for (int p = 0; p <= NBR_PROFILE_PHASES; p++)
+	{
+		const StarHistogram &histogram = p < NBR_PROFILE_PHASES ? phases[p] : frames;
+		if (histogram.Count() == 0)
+			continue;
+		fprintf(out, "%-20s %10llu %10.1f %10.1f %10.1f\n",
+			p < NBR_PROFILE_PHASES ? ProfilePhaseName((ProfilePhase)p) : "frame",
+			(unsigned long long)histogram.Count(), histogram.Percentile(50.0) * 1e-3,
+			histogram.Percentile(99.0) * 1e-3, histogram.Max() * 1e-3);
+	}
+}
@@ -0,0 +1,108 @@
+/***********************************************************************/
+/* Filename: StarProfiler.h                                            */
+/* Per-phase frame profiler. Code brackets each phase of a frame with */
+/* Begin() and End() (or a ProfileScope); phases may nest, and time   */
+/* spent in an inner phase is not charged to the outer one. At the    */
+/* end of each frame every phase that ran records its total for the   */
+/* frame in a histogram, from which percentiles are reported.         */
+/*                                                                     */
+/* The histograms are log-linear in the manner of HdrHistogram: exact */
+/* below 64 ns, then 32 buckets per power of two, so any recorded     */
+/* time is reported to within about 3% using a fixed 15 KB per phase. */
+/***********************************************************************/
+
+#ifndef STAR_PROFILER_H
+#define STAR_PROFILER_H
+
+#include <cstdint>
+#include <cstdio>
+#include "StarClock.h"
+
+// Phases of a frame, in report order. //
+enum ProfilePhase
+{
+	PHASE_MOTION,                     // Pulsation, motion and wall reflection (the kinematics kernel). //
+	PHASE_THAW,                       // Releasing stars whose freeze has run out.  //
+	PHASE_BROAD_PHASE,                // Rebuilding the collision candidate search. //
+	PHASE_COLLISION_DETECTION,        // Finding and answering collisions.          //
+	PHASE_COLLISION_EFFECTS,          // Stage changes of the stars that collided.  //
+	PHASE_TITLE,                      // Updating the window title.                 //
+	PHASE_DRAW,                       // Submitting the stars to the GL.            //
+	PHASE_SWAP,                       // Swapping and flushing the frame buffers.   //
+	NBR_PROFILE_PHASES
+};
+const char *ProfilePhaseName(ProfilePhase phase);
+
+const int HISTOGRAM_SUB_BITS = 5;                             // log2 of the buckets per power of two. //
+const int HISTOGRAM_BUCKETS = 2 << HISTOGRAM_SUB_BITS;        // Exact buckets, and buckets per octave after. //
+const int NBR_HISTOGRAM_BUCKETS = HISTOGRAM_BUCKETS + (63 - HISTOGRAM_SUB_BITS - 1) * (HISTOGRAM_BUCKETS / 2);
+const int MAX_PROFILE_DEPTH = 8;                              // Deepest nesting of phases. //
+
+class StarHistogram
+{
+public:
+	StarHistogram();
+
+	void Record(int64_t value);
+	void Reset();
+
+	uint64_t Count() const { return count; }
+	int64_t  Max() const { return max; }
+	int64_t  Percentile(double percent) const;
+
+private:
+	uint64_t buckets[NBR_HISTOGRAM_BUCKETS];
+	uint64_t count;
+	int64_t  max;
+};
+
+class StarProfiler
+{
+public:
+	StarProfiler();
+
+	void Begin(ProfilePhase phase);
+	void End();
+	void EndFrame();
+	void Reset();
+	void Report(FILE *out) const;
+
+	const StarHistogram &Phase(ProfilePhase phase) const { return phases[phase]; }
+	const StarHistogram &Frame() const { return frames; }
+
+private:
+	StarHistogram phases[NBR_PROFILE_PHASES];
+	StarHistogram frames;             // Sum of the timed phases of each frame. //
+
+	// The frame in progress. //
+	int64_t frameNanoseconds[NBR_PROFILE_PHASES];
+	bool    ran[NBR_PROFILE_PHASES];
+	ProfilePhase stack[MAX_PROFILE_DEPTH];    // Phases begun and not yet ended, innermost last. //
+	int     depth;
+	int64_t mark;                     // Clock reading when the innermost phase last resumed. //
+};
+
+/* Times the enclosing block as the parameterized phase, if there is */
+/* a profiler.                                                       */
+class ProfileScope
+{
+public:
+	ProfileScope(StarProfiler *profiler, ProfilePhase phase) : profiler(profiler)
+	{
+		if (profiler != NULL)
+			profiler->Begin(phase);
+	}
+	~ProfileScope()
+	{
+		if (profiler != NULL)
+			profiler->End();
+	}
+
+private:
+	StarProfiler *profiler;
+
+	ProfileScope(const ProfileScope &);
+	ProfileScope &operator=(const ProfileScope &);
+};
+
+#endif
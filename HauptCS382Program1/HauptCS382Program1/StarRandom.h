@@ -0,0 +1,59 @@
+/***********************************************************************/
+/* Filename: StarRandom.h                                              */
+/* Counter-based random numbers. Every value is a pure function of a  */
+/* seed, a stream (a star's index, say) and the number of values      */
+/* drawn from that stream so far, hashed with SplitMix64's mixer.     */
+/* There is no shared state, so streams can be drawn on any thread in */
+/* any order, and a run is reproduced exactly from its seed.          */
+/***********************************************************************/
+
+#ifndef STAR_RANDOM_H
+#define STAR_RANDOM_H
+
+#include <cstdint>
+
+const uint64_t RANDOM_GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;  // SplitMix64's counter increment. //
+
+/* SplitMix64's output function: a bijective avalanche of 64 bits. */
+inline uint64_t MixBits(uint64_t z)
+{
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+class StarRandom
+{
+public:
+	StarRandom(uint64_t seed, uint64_t stream)
+	{
+		key = MixBits(seed + MixBits(stream * RANDOM_GOLDEN_GAMMA + RANDOM_GOLDEN_GAMMA));
+		counter = 0;
+	}
+
+	/* The next 64 random bits of the stream. */
+	uint64_t NextBits()
+	{
+		counter++;
+		return MixBits(key + counter * RANDOM_GOLDEN_GAMMA);
+	}
+
+	/* The next value of the stream, uniform in [lowerBound, upperBound). */
+	float Uniform(float lowerBound, float upperBound)
+	{
+		float unit = (float)(NextBits() >> 40) * (1.0f / 16777216.0f);
+		return lowerBound + (upperBound - lowerBound) * unit;
+	}
+
+	/* The next value of the stream, uniform in [0, limit). */
+	int Below(int limit)
+	{
+		return (int)((NextBits() >> 33) % (uint64_t)limit);
+	}
+
+private:
+	uint64_t key;                     // Seed and stream, mixed. //
+	uint64_t counter;                 // # values drawn so far.  //
+};
+
+#endif
@@ -0,0 +1,296 @@
+/***********************************************************************/
+/* Filename: StarRenderer.cpp                                          */
+/* Single-call star drawing from a streamed vertex buffer.            */
+/***********************************************************************/
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <GL/gl.h>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include "StarRenderer.h"
+using namespace std;
+
+// GL 1.5 - 4.4 names that the platform's gl.h may not declare. //
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER               0x8892
+#define GL_STREAM_DRAW                0x88E0
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT              0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT         0x0040
+#define GL_MAP_COHERENT_BIT           0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT    0x00000001
+#define GL_TIMEOUT_EXPIRED            0x911B
+#endif
+
+typedef ptrdiff_t StarGLsizeiptr;
+typedef ptrdiff_t StarGLintptr;
+typedef void *StarGLsync;
+
+typedef void (APIENTRY *GenBuffersProc)(GLsizei n, GLuint *buffers);
+typedef void (APIENTRY *DeleteBuffersProc)(GLsizei n, const GLuint *buffers);
+typedef void (APIENTRY *BindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY *BufferDataProc)(GLenum target, StarGLsizeiptr size, const void *data, GLenum usage);
+typedef void (APIENTRY *BufferSubDataProc)(GLenum target, StarGLintptr offset, StarGLsizeiptr size, const void *data);
+typedef void (APIENTRY *BufferStorageProc)(GLenum target, StarGLsizeiptr size, const void *data, GLbitfield flags);
+typedef void *(APIENTRY *MapBufferRangeProc)(GLenum target, StarGLintptr offset, StarGLsizeiptr length, GLbitfield access);
+typedef GLboolean (APIENTRY *UnmapBufferProc)(GLenum target);
+typedef StarGLsync (APIENTRY *FenceSyncProc)(GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRY *ClientWaitSyncProc)(StarGLsync sync, GLbitfield flags, unsigned long long timeout);
+typedef void (APIENTRY *DeleteSyncProc)(StarGLsync sync);
+typedef void (APIENTRY *MultiDrawArraysProc)(GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount);
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const unsigned long long FENCE_TIMEOUT_NSEC = 1000000000ULL;   // Longest single wait on a fence. //
+
+static GenBuffersProc      genBuffers;
+static DeleteBuffersProc   deleteBuffers;
+static BindBufferProc      bindBuffer;
+static BufferDataProc      bufferData;
+static BufferSubDataProc   bufferSubData;
+static BufferStorageProc   bufferStorage;
+static MapBufferRangeProc  mapBufferRange;
+static UnmapBufferProc     unmapBuffer;
+static FenceSyncProc       fenceSync;
+static ClientWaitSyncProc  clientWaitSync;
+static DeleteSyncProc      deleteSync;
+static MultiDrawArraysProc multiDrawArrays;
+
+
+/* Whether the current context is at least the parameterized version */
+/* or advertises the parameterized extension.                        */
+static bool HasGL(int major, int minor, const char *extension)
+{
+	const char *version = (const char *)glGetString(GL_VERSION);
+	if (version != NULL)
+	{
+		int haveMajor = atoi(version);
+		const char *dot = strchr(version, '.');
+		int haveMinor = dot != NULL ? atoi(dot + 1) : 0;
+		if (haveMajor > major || (haveMajor == major && haveMinor >= minor))
+			return true;
+	}
+	const char *extensions = (const char *)glGetString(GL_EXTENSIONS);
+	if (extensions == NULL || extension == NULL)
+		return false;
+	size_t length = strlen(extension);
+	for (const char *found = strstr(extensions, extension); found != NULL; found = strstr(found + length, extension))
+		if ((found == extensions || found[-1] == ' ') && (found[length] == ' ' || found[length] == '\0'))
+			return true;
+	return false;
+}
+
+
+StarRenderer::StarRenderer()
+{
+	ready = false;
+	persistent = false;
+	buffer = 0;
+	capacity = 0;
+	region = 0;
+	mapped = NULL;
+	for (int r = 0; r < RENDER_REGIONS; r++)
+		fence[r] = NULL;
+}
+
+/* Look up the buffer entry points. Returns false (and the front end  */
+/* should keep drawing in immediate mode) if vertex buffers or        */
+/* glMultiDrawArrays are missing; persistent mapping is optional.     */
+bool StarRenderer::Init(StarGLLoader loader)
+{
+	Shutdown();
+	genBuffers = (GenBuffersProc)loader("glGenBuffers");
+	deleteBuffers = (DeleteBuffersProc)loader("glDeleteBuffers");
+	bindBuffer = (BindBufferProc)loader("glBindBuffer");
+	bufferData = (BufferDataProc)loader("glBufferData");
+	bufferSubData = (BufferSubDataProc)loader("glBufferSubData");
+	multiDrawArrays = (MultiDrawArraysProc)loader("glMultiDrawArrays");
+	if (!HasGL(1, 5, NULL) || genBuffers == NULL || deleteBuffers == NULL || bindBuffer == NULL ||
+		bufferData == NULL || bufferSubData == NULL || multiDrawArrays == NULL)
+		return false;
+
+	bufferStorage = NULL;
+	if (HasGL(4, 4, "GL_ARB_buffer_storage") && HasGL(3, 2, "GL_ARB_sync"))
+	{
+		bufferStorage = (BufferStorageProc)loader("glBufferStorage");
+		mapBufferRange = (MapBufferRangeProc)loader("glMapBufferRange");
+		unmapBuffer = (UnmapBufferProc)loader("glUnmapBuffer");
+		fenceSync = (FenceSyncProc)loader("glFenceSync");
+		clientWaitSync = (ClientWaitSyncProc)loader("glClientWaitSync");
+		deleteSync = (DeleteSyncProc)loader("glDeleteSync");
+		if (mapBufferRange == NULL || unmapBuffer == NULL || fenceSync == NULL ||
+			clientWaitSync == NULL || deleteSync == NULL)
+			bufferStorage = NULL;
+	}
+
+	ready = true;
+	return true;
+}
+
+/* Release the vertex buffer and any outstanding fences. */
+void StarRenderer::Shutdown()
+{
+	if (!ready)
+		return;
+	for (int r = 0; r < RENDER_REGIONS; r++)
+	{
+		if (fence[r] != NULL)
+			deleteSync(fence[r]);
+		fence[r] = NULL;
+	}
+	if (buffer != 0)
+	{
+		if (mapped != NULL)
+		{
+			bindBuffer(GL_ARRAY_BUFFER, buffer);
+			unmapBuffer(GL_ARRAY_BUFFER);
+			bindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+		deleteBuffers(1, &buffer);
+	}
+	buffer = 0;
+	mapped = NULL;
+	capacity = 0;
+	persistent = false;
+	ready = false;
+}
+
+/* Make room for the parameterized number of stars, recreating the */
+/* buffer (and the per-star draw ranges) when the count changes.   */
+bool StarRenderer::Reserve(int nbrStars)
+{
+	if (nbrStars == capacity && buffer != 0)
+		return true;
+
+	bool wasReady = ready;
+	Shutdown();
+	ready = wasReady;
+	capacity = nbrStars;
+	region = 0;
+
+	first.resize(nbrStars);
+	count.resize(nbrStars);
+	for (int i = 0; i < nbrStars; i++)
+	{
+		first[i] = i * VERTICES_PER_STAR;
+		count[i] = VERTICES_PER_STAR;
+	}
+
+	StarGLsizeiptr regionBytes = (StarGLsizeiptr)nbrStars * VERTICES_PER_STAR * sizeof(Vertex);
+	genBuffers(1, &buffer);
+	bindBuffer(GL_ARRAY_BUFFER, buffer);
+	if (bufferStorage != NULL)
+	{
+		// One allocation, mapped once for the life of the buffer. //
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		bufferStorage(GL_ARRAY_BUFFER, RENDER_REGIONS * regionBytes, NULL, flags);
+		mapped = (Vertex *)mapBufferRange(GL_ARRAY_BUFFER, 0, RENDER_REGIONS * regionBytes, flags);
+		persistent = mapped != NULL;
+	}
+	if (!persistent)
+	{
+		// Fall back to streaming: a fresh store every frame. //
+		if (mapped == NULL && bufferStorage != NULL)
+		{
+			deleteBuffers(1, &buffer);
+			genBuffers(1, &buffer);
+			bindBuffer(GL_ARRAY_BUFFER, buffer);
+		}
+		bufferData(GL_ARRAY_BUFFER, regionBytes, NULL, GL_STREAM_DRAW);
+		staging.resize((size_t)nbrStars * VERTICES_PER_STAR);
+	}
+	bindBuffer(GL_ARRAY_BUFFER, 0);
+	return buffer != 0;
+}
+
+/* Block until the GPU has finished drawing from the indexed region. */
+/* With three regions this only happens when it is frames behind.    */
+void StarRenderer::WaitForRegion(int index)
+{
+	if (fence[index] == NULL)
+		return;
+	while (clientWaitSync(fence[index], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT_NSEC) == GL_TIMEOUT_EXPIRED)
+		;
+	deleteSync(fence[index]);
+	fence[index] = NULL;
+}
+
+/* Fill the parameterized vertex array with every star's outline,  */
+/* drawn the parameterized fraction of a tick past its previous    */
+/* position (the outline is placed at the latest position and      */
+/* shifted back to the point between ticks being drawn).           */
+void StarRenderer::WriteVertices(const StarFrame &frame, float alpha, Vertex *vertices)
+{
+	for (int i = 0; i < frame.nbrStars; i++)
+	{
+		float shiftX = (1.0f - alpha) * (frame.prevX[i] - frame.x[i]);
+		float shiftY = (1.0f - alpha) * (frame.prevY[i] - frame.y[i]);
+		unsigned char rgba[4];
+		for (int c = 0; c < 3; c++)
+			rgba[c] = (unsigned char)(frame.color[3 * i + c] * 255.0f + 0.5f);
+		rgba[3] = 255;
+
+		Vertex *vertex = vertices + (size_t)i * VERTICES_PER_STAR;
+		for (int j = 0; j < VERTICES_PER_STAR; j++, vertex++)
+		{
+			float vertexX, vertexY;
+			frame.OutlineVertex(i, j, vertexX, vertexY);
+			vertex->x = vertexX + shiftX;
+			vertex->y = vertexY + shiftY;
+			memcpy(vertex->color, rgba, sizeof(rgba));
+		}
+	}
+}
+
+/* Draw every star of the frame with one glMultiDrawArrays call. */
+void StarRenderer::Draw(const StarFrame &frame, float alpha)
+{
+	if (!ready || frame.nbrStars == 0 || !Reserve(frame.nbrStars))
+		return;
+
+	const char *base;
+	bindBuffer(GL_ARRAY_BUFFER, buffer);
+	if (persistent)
+	{
+		WaitForRegion(region);
+		size_t offset = (size_t)region * capacity * VERTICES_PER_STAR;
+		WriteVertices(frame, alpha, mapped + offset);
+		base = (const char *)(offset * sizeof(Vertex));
+	}
+	else
+	{
+		WriteVertices(frame, alpha, &staging[0]);
+		StarGLsizeiptr bytes = (StarGLsizeiptr)staging.size() * sizeof(Vertex);
+		bufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+		bufferSubData(GL_ARRAY_BUFFER, 0, bytes, &staging[0]);
+		base = NULL;
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, x));
+	glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), base + offsetof(Vertex, color));
+	multiDrawArrays(GL_LINE_LOOP, &first[0], &count[0], frame.nbrStars);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	bindBuffer(GL_ARRAY_BUFFER, 0);
+
+	if (persistent)
+	{
+		fence[region] = fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		region = (region + 1) % RENDER_REGIONS;
+	}
+}
@@ -0,0 +1,62 @@
+/***********************************************************************/
+/* Filename: StarRenderer.h                                            */
+/* Draws every star with a single GL call. Each frame the outlines    */
+/* are written into one third of a persistently mapped vertex buffer  */
+/* (GL 4.4 or ARB_buffer_storage), guarded by a fence so the CPU      */
+/* never overwrites vertices the GPU is still reading, and drawn with */
+/* one glMultiDrawArrays. Without buffer storage the vertices are     */
+/* streamed into an orphaned buffer instead. Only fixed-function      */
+/* state is used, so the existing glOrtho projection still applies.  */
+/***********************************************************************/
+
+#ifndef STAR_RENDERER_H
+#define STAR_RENDERER_H
+
+#include <vector>
+#include "StarFrame.h"
+
+// GL entry points are looked up at run time through the window system. //
+typedef void (*StarGLProc)();
+typedef StarGLProc (*StarGLLoader)(const char *name);
+
+const int RENDER_REGIONS = 3;                         // Frames the vertex buffer holds at once. //
+const int VERTICES_PER_STAR = 2 * NBR_STAR_TIPS;      // Outline vertices drawn per star.        //
+
+class StarRenderer
+{
+public:
+	StarRenderer();
+
+	bool Init(StarGLLoader loader);   // Call with the GL context current. //
+	void Shutdown();                  // Likewise; frees the GL objects.    //
+	bool Ready() const { return ready; }
+	bool Persistent() const { return persistent; }
+
+	void Draw(const StarFrame &frame, float alpha);
+
+private:
+	struct Vertex
+	{
+		float x;
+		float y;
+		unsigned char color[4];
+	};
+
+	bool ready;
+	bool persistent;                  // Persistently mapped, fenced buffer in use. //
+	unsigned int buffer;              // GL vertex buffer name.                      //
+	int  capacity;                    // # stars one region holds.                   //
+	int  region;                      // Region written by the next frame.           //
+	Vertex *mapped;                   // Start of the persistent mapping.            //
+	void *fence[RENDER_REGIONS];      // Signalled once the GPU is done with a region. //
+
+	std::vector<Vertex> staging;      // Frame vertices when not persistently mapped. //
+	std::vector<int> first;           // First vertex of each star's line loop.       //
+	std::vector<int> count;           // # vertices in each star's line loop.         //
+
+	bool Reserve(int nbrStars);
+	void WriteVertices(const StarFrame &frame, float alpha, Vertex *vertices);
+	void WaitForRegion(int index);
+};
+
+#endif
@@ -0,0 +1,172 @@
+/***********************************************************************/
+/* Filename: StarReplay.cpp                                            */
+/* Writing and reading replay files.                                   */
+/***********************************************************************/
+
+#include "StarReplay.h"
+#include <cstring>			// Header File For memset()
+using namespace std;
+
+
+StarReplay::StarReplay()
+{
+	memset(&header, 0, sizeof(header));
+	file = NULL;
+}
+
+StarReplay::~StarReplay()
+{
+	if (file != NULL)
+		fclose(file);
+}
+
+/* Start recording the parameterized freshly reset world, simulated at */
+/* the parameterized rate. Returns false if the file cannot be made.   */
+bool StarReplay::Create(const char *fileName, const StarWorld &world, int simHz)
+{
+#ifdef _MSC_VER
+	if (fopen_s(&file, fileName, "wb") != 0)
+		file = NULL;
+#else
+	file = fopen(fileName, "wb");
+#endif
+	if (file == NULL)
+		return false;
+
+	memset(&header, 0, sizeof(header));
+	header.magic = REPLAY_MAGIC;
+	header.version = REPLAY_VERSION;
+	header.eventSize = sizeof(ReplayEvent);
+	header.seed = world.seed;
+	header.nbrStars = world.nbrStars;
+	header.simHz = simHz;
+	header.broadPhase = world.broadPhase;
+	header.collisionMode = world.collisionMode;
+	header.windowWidth = world.windowWidth;
+	header.windowHeight = world.windowHeight;
+	header.stageChecksum = world.stages.Checksum();
+	fwrite(&header, sizeof(header), 1, file);
+	fflush(file);
+	return true;
+}
+
+/* Append one event at the world's current tick. Input is rare, so   */
+/* every event goes straight to disk and survives a crash.           */
+void StarReplay::Write(const StarWorld &world, ReplayEventType type, int a, int b)
+{
+	if (file == NULL)
+		return;
+	ReplayEvent event;
+	event.tick = world.tickCount;
+	event.type = (uint16_t)type;
+	event.reserved[0] = event.reserved[1] = event.reserved[2] = 0;
+	event.a = a;
+	event.b = b;
+	fwrite(&event, sizeof(event), 1, file);
+	fflush(file);
+}
+
+/* Record a click that froze or released the indexed star. */
+void StarReplay::RecordClick(const StarWorld &world, int index)
+{
+	Write(world, REPLAY_CLICK, index, 0);
+}
+
+/* Record a window resize to the parameterized size. */
+void StarReplay::RecordResize(const StarWorld &world, int w, int h)
+{
+	Write(world, REPLAY_RESIZE, w, h);
+}
+
+/* Fill in the closing totals and close the recording. */
+void StarReplay::Finish(const StarWorld &world)
+{
+	if (file == NULL)
+		return;
+	header.nbrTicks = world.tickCount;
+	header.totalCollisions = world.TOTAL_COLLISIONS;
+	header.gameSeconds = world.GAME_SECONDS;
+	fseek(file, 0, SEEK_SET);
+	fwrite(&header, sizeof(header), 1, file);
+	fclose(file);
+	file = NULL;
+}
+
+/* Read a recording for playback; returns false if the file is missing, */
+/* is not a replay, or names stars the game does not have.              */
+bool StarReplay::Load(const char *fileName)
+{
+	FILE *input;
+#ifdef _MSC_VER
+	if (fopen_s(&input, fileName, "rb") != 0)
+		input = NULL;
+#else
+	input = fopen(fileName, "rb");
+#endif
+	if (input == NULL)
+		return false;
+
+	bool valid = fread(&header, sizeof(header), 1, input) == 1 &&
+		header.magic == REPLAY_MAGIC && header.version == REPLAY_VERSION &&
+		header.eventSize == sizeof(ReplayEvent) &&
+		header.nbrStars >= 1 && header.nbrStars <= MAX_STARS &&
+		header.simHz >= 1 && header.simHz <= MAX_SIM_HZ &&
+		header.broadPhase >= BROAD_PHASE_BRUTE_FORCE && header.broadPhase <= BROAD_PHASE_SWEEP &&
+		header.collisionMode >= COLLISION_DISCRETE && header.collisionMode <= COLLISION_CONTINUOUS &&
+		header.windowWidth > 0.0f && header.windowHeight > 0.0f;
+	events.clear();
+	ReplayEvent event;
+	while (valid && fread(&event, sizeof(event), 1, input) == 1)
+	{
+		if (event.type == REPLAY_CLICK)
+			valid = event.a >= 0 && event.a < header.nbrStars;
+		else if (event.type == REPLAY_RESIZE)
+			valid = event.a > 0 && event.b > 0;
+		else
+			valid = false;
+		if (!events.empty() && event.tick < events.back().tick)
+			valid = false;
+		events.push_back(event);
+	}
+	fclose(input);
+	if (!valid)
+		events.clear();
+	return valid;
+}
+
+/* Configure and reset the parameterized world exactly as the recorded */
+/* game started.                                                       */
+void StarReplay::Setup(StarWorld &world) const
+{
+	world.seed = header.seed;
+	world.broadPhase = (BroadPhase)header.broadPhase;
+	world.collisionMode = (CollisionMode)header.collisionMode;
+	world.tickSeconds = 1.0f / header.simHz;
+	world.windowWidth = header.windowWidth;
+	world.windowHeight = header.windowHeight;
+	world.Reset(header.nbrStars, 0.0);
+}
+
+/* Apply, in order, the events recorded after as many ticks as the     */
+/* world has now completed, starting from the indexed event; advances  */
+/* the index past them.                                                */
+void StarReplay::Apply(StarWorld &world, size_t &nextEvent) const
+{
+	while (nextEvent < events.size() && events[nextEvent].tick <= world.tickCount)
+	{
+		const ReplayEvent &event = events[nextEvent++];
+		if (event.type == REPLAY_CLICK)
+			world.ToggleFreeze(event.a);
+		else
+			world.SetViewport(event.a, event.b);
+	}
+}
+
+/* Ticks the recorded game ran for: the recorded total if the recording */
+/* was finished, otherwise through its last event.                      */
+uint64_t StarReplay::LastTick() const
+{
+	if (header.nbrTicks > 0)
+		return header.nbrTicks;
+	return events.empty() ? 0 : events.back().tick;
+}
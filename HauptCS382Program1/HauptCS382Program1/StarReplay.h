@@ -0,0 +1,90 @@
+/***********************************************************************/
+/* Filename: StarReplay.h                                              */
+/* Input recording. A game is fully determined by its seed, its       */
+/* settings and the player's input, so a replay file holds just those:*/
+/* a ReplayHeader, then one ReplayEvent per freeze/unfreeze click or  */
+/* window resize, tagged with the tick it came after. The headless    */
+/* front end re-runs a recording at full speed.                       */
+/*                                                                     */
+/* The header's closing totals are filled in when the recording is    */
+/* finished, so that a replay can check it reached the same result.   */
+/***********************************************************************/
+
+#ifndef STAR_REPLAY_H
+#define STAR_REPLAY_H
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "StarWorld.h"
+
+// Kinds of recorded input. //
+enum ReplayEventType
+{
+	REPLAY_CLICK = 1,                 // Star a was frozen or released.          //
+	REPLAY_RESIZE                     // Window resized to a by b pixels.        //
+};
+
+const uint32_t REPLAY_MAGIC = 0x50525453;     // "STRP" in a little-endian file. //
+const uint16_t REPLAY_VERSION = 5;
+
+struct ReplayHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t eventSize;               // sizeof(ReplayEvent). //
+	uint64_t seed;
+	int32_t  nbrStars;
+	int32_t  simHz;
+	int32_t  broadPhase;              // BroadPhase in use. //
+	int32_t  collisionMode;           // CollisionMode in use. //
+	float    windowWidth;             // World extents the stars were spawned in. //
+	float    windowHeight;
+	uint32_t stageChecksum;           // StarStageTable::Checksum() of the stages in use. //
+
+	// Closing totals; zero ticks if the recording was never finished. //
+	int32_t  gameSeconds;
+	uint64_t nbrTicks;
+	uint64_t totalCollisions;
+};
+
+struct ReplayEvent
+{
+	uint64_t tick;                    // Ticks completed before the input arrived. //
+	uint16_t type;                    // ReplayEventType. //
+	uint16_t reserved[3];
+	int32_t  a;
+	int32_t  b;
+};
+
+class StarReplay
+{
+public:
+	StarReplay();
+	~StarReplay();
+
+	// Recording; call Create() once the world has been reset. //
+	bool Create(const char *fileName, const StarWorld &world, int simHz);
+	void RecordClick(const StarWorld &world, int index);
+	void RecordResize(const StarWorld &world, int w, int h);
+	void Finish(const StarWorld &world);
+
+	// Playback. //
+	bool Load(const char *fileName);
+	const ReplayHeader &Header() const { return header; }
+	void Setup(StarWorld &world) const;
+	void Apply(StarWorld &world, size_t &nextEvent) const;
+	uint64_t LastTick() const;
+
+private:
+	ReplayHeader header;
+	std::vector<ReplayEvent> events;  // Loaded events (playback only). //
+	FILE *file;                       // Open recording, or NULL. //
+
+	void Write(const StarWorld &world, ReplayEventType type, int a, int b);
+
+	StarReplay(const StarReplay &);
+	StarReplay &operator=(const StarReplay &);
+};
+
+#endif
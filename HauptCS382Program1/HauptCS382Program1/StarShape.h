@@ -0,0 +1,107 @@
+/***********************************************************************/
+/* Filename: StarShape.h                                               */
+/* The unit star outline, generated at compile time. A star's outline */
+/* alternates between tips (radius 1) and notches (radius 0.5), with  */
+/* the first tip along the x-axis. Drawing and boundary checks rotate */
+/* this table by the star's spin, so each star needs only one sin/cos */
+/* pair per tick instead of one per vertex.                           */
+/***********************************************************************/
+
+#ifndef STAR_SHAPE_H
+#define STAR_SHAPE_H
+
+constexpr double STAR_SHAPE_PI = 3.14159265358979323846;
+constexpr float  NOTCH_RATIO = 0.5f;                      // Notch radius relative to tip radius. //
+
+/* Compile-time angle reduction into [-pi, pi]. Every constexpr     */
+/* function here is a single return, so C++11 compilers (Visual      */
+/* Studio 2015 among them) evaluate the table at compile time too.   */
+constexpr double ReduceAngle(double radians)
+{
+	return radians > STAR_SHAPE_PI ? ReduceAngle(radians - 2.0 * STAR_SHAPE_PI) :
+		(radians < -STAR_SHAPE_PI ? ReduceAngle(radians + 2.0 * STAR_SHAPE_PI) : radians);
+}
+
+/* Taylor series terms n through 19 of the sine of the parameterized */
+/* (reduced) angle, added to the sum of the earlier ones.            */
+constexpr double SineTerms(double radians, double term, double sum, int n)
+{
+	return n >= 20 ? sum :
+		SineTerms(radians, term * (-radians * radians / ((2 * n) * (2 * n + 1))),
+			sum + term * (-radians * radians / ((2 * n) * (2 * n + 1))), n + 1);
+}
+
+/* Compile-time sine: the Taylor series after reducing the angle into */
+/* [-pi, pi], accurate to double precision there.                     */
+constexpr double ConstexprSine(double radians)
+{
+	return SineTerms(ReduceAngle(radians), ReduceAngle(radians), ReduceAngle(radians), 1);
+}
+
+constexpr double ConstexprCosine(double radians)
+{
+	return ConstexprSine(radians + STAR_SHAPE_PI / 2.0);
+}
+
+// Outline vertices of a unit star with the parameterized number of tips; //
+// vertex 2k is tip k and vertex 2k+1 the notch after it.                 //
+template <int NBR_TIPS>
+struct StarOutline
+{
+	static const int NBR_VERTICES = 2 * NBR_TIPS;
+	float x[NBR_VERTICES];
+	float y[NBR_VERTICES];
+};
+
+// Vertex indices 0 through N - 1, as a parameter pack. //
+template <int... VERTICES>
+struct OutlineIndices {};
+template <int N, int... VERTICES>
+struct MakeOutlineIndices : MakeOutlineIndices<N - 1, N - 1, VERTICES...> {};
+template <int... VERTICES>
+struct MakeOutlineIndices<0, VERTICES...>
+{
+	typedef OutlineIndices<VERTICES...> Type;
+};
+
+/* Coordinates of the indexed vertex of the unit outline. */
+template <int NBR_TIPS>
+constexpr float OutlineX(int vertex)
+{
+	return (float)((vertex % 2 == 0 ? 1.0 : NOTCH_RATIO) * ConstexprCosine(vertex * STAR_SHAPE_PI / NBR_TIPS));
+}
+
+template <int NBR_TIPS>
+constexpr float OutlineY(int vertex)
+{
+	return (float)((vertex % 2 == 0 ? 1.0 : NOTCH_RATIO) * ConstexprSine(vertex * STAR_SHAPE_PI / NBR_TIPS));
+}
+
+template <int NBR_TIPS, int... VERTICES>
+constexpr StarOutline<NBR_TIPS> BuildStarOutline(OutlineIndices<VERTICES...>)
+{
+	return StarOutline<NBR_TIPS>{ { OutlineX<NBR_TIPS>(VERTICES)... }, { OutlineY<NBR_TIPS>(VERTICES)... } };
+}
+
+template <int NBR_TIPS>
+constexpr StarOutline<NBR_TIPS> MakeStarOutline()
+{
+	return BuildStarOutline<NBR_TIPS>(typename MakeOutlineIndices<2 * NBR_TIPS>::Type());
+}
+
+/* Position of the parameterized vertex of the parameterized outline */
+/* for a star centered at (centerX, centerY): the unit vertex,       */
+/* rotated by the spin whose cosine and sine are given and scaled by */
+/* the pulsed tip radius. The world and the frames it publishes both */
+/* place vertices through this, so they agree to the last bit.       */
+template <int NBR_TIPS>
+inline void PlaceOutlineVertex(const StarOutline<NBR_TIPS> &outline, int vertex, float centerX, float centerY,
+	float tipRadius, float spinCos, float spinSin, float &vertexX, float &vertexY)
+{
+	float unitX = outline.x[vertex];
+	float unitY = outline.y[vertex];
+	vertexX = centerX + tipRadius * (unitX * spinCos - unitY * spinSin);
+	vertexY = centerY + tipRadius * (unitX * spinSin + unitY * spinCos);
+}
+
+#endif
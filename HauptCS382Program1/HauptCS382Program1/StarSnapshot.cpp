@@ -0,0 +1,202 @@
+/***********************************************************************/
+/* Filename: StarSnapshot.cpp                                          */
+/* Writing world snapshots, and restoring them through a mapping.      */
+/***********************************************************************/
+
+#include "StarSnapshot.h"
+#include <cstdio>
+#include <cstring>			// Header File For memcpy()
+#include "StarMappedFile.h"
+using namespace std;
+
+
+// One per-star array of the world, as saved. //
+struct SectionData
+{
+	SnapshotSectionId id;
+	uint32_t elementSize;
+	uint32_t perStar;                 // Elements per star. //
+	uint64_t bytes;
+	void *data;
+};
+
+/* Describe every per-star array of the parameterized world, in file */
+/* order; the arrays must already be sized for its stars.           */
+static void ListSections(StarWorld &world, SectionData sections[NBR_SNAPSHOT_SECTIONS])
+{
+	struct { SnapshotSectionId id; uint32_t elementSize; uint32_t perStar; void *data; } list[NBR_SNAPSHOT_SECTIONS] = {
+		{ SECTION_X,             sizeof(float),  1, world.x.data() },
+		{ SECTION_Y,             sizeof(float),  1, world.y.data() },
+		{ SECTION_PREV_X,        sizeof(float),  1, world.prevX.data() },
+		{ SECTION_PREV_Y,        sizeof(float),  1, world.prevY.data() },
+		{ SECTION_X_INC,         sizeof(float),  1, world.xInc.data() },
+		{ SECTION_Y_INC,         sizeof(float),  1, world.yInc.data() },
+		{ SECTION_SPIN,          sizeof(float),  1, world.spin.data() },
+		{ SECTION_SPIN_INC,      sizeof(float),  1, world.spinInc.data() },
+		{ SECTION_SPIN_COS,      sizeof(float),  1, world.spinCos.data() },
+		{ SECTION_SPIN_SIN,      sizeof(float),  1, world.spinSin.data() },
+		{ SECTION_PULSATION,     sizeof(float),  1, world.pulsation.data() },
+		{ SECTION_PULSATION_INC, sizeof(float),  1, world.pulsationInc.data() },
+		{ SECTION_RADIUS,        sizeof(float),  1, world.radius.data() },
+		{ SECTION_FREEZE_LIMIT,  sizeof(int),    1, world.freezeLimit.data() },
+		{ SECTION_FREEZE_DEADLINE, sizeof(unsigned long), 1, world.freezeDeadline.data() },
+		{ SECTION_COLLISION_CNT, sizeof(int),    1, world.collisionCnt.data() },
+		{ SECTION_COLOR,         sizeof(float),  3, world.color.data() },
+		{ SECTION_STAGE,         sizeof(int),    1, world.stage.data() },
+		{ SECTION_BASE_PULSATION_INC, sizeof(float), 1, world.basePulsationInc.data() },
+		{ SECTION_BASE_SPIN_INC, sizeof(float),  1, world.baseSpinInc.data() },
+	};
+	for (int s = 0; s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		sections[s].id = list[s].id;
+		sections[s].elementSize = list[s].elementSize;
+		sections[s].perStar = list[s].perStar;
+		sections[s].bytes = (uint64_t)world.nbrStars * list[s].perStar * list[s].elementSize;
+		sections[s].data = list[s].data;
+	}
+}
+
+/* Round the parameterized offset up to the next section boundary. */
+static uint64_t AlignOffset(uint64_t offset)
+{
+	return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+/* Write the parameterized world to the parameterized file; returns */
+/* false if the file could not be written in full.                  */
+bool SaveSnapshot(const char *fileName, const StarWorld &world)
+{
+	SnapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = SNAPSHOT_MAGIC;
+	header.version = SNAPSHOT_VERSION;
+	header.nbrSections = NBR_SNAPSHOT_SECTIONS;
+	header.headerSize = sizeof(SnapshotHeader);
+	header.nbrStars = world.nbrStars;
+	header.seed = world.seed;
+	header.tickCount = world.tickCount;
+	header.startTime = world.startTime;
+	header.tickSeconds = world.tickSeconds;
+	header.windowWidth = world.windowWidth;
+	header.windowHeight = world.windowHeight;
+	header.broadPhase = world.broadPhase;
+	header.totalCollisions = world.TOTAL_COLLISIONS;
+	header.yellowStars = world.YELLOW_STARS;
+	header.callInc = world.CallInc;
+	header.gameSeconds = world.GAME_SECONDS;
+	header.gameOver = world.gameOver ? 1 : 0;
+	header.collisionMode = world.collisionMode;
+	header.stageChecksum = world.stages.Checksum();
+
+	// The world is only read here. //
+	SectionData data[NBR_SNAPSHOT_SECTIONS];
+	ListSections(const_cast<StarWorld &>(world), data);
+	SnapshotSection table[NBR_SNAPSHOT_SECTIONS];
+	uint64_t offset = sizeof(header) + sizeof(table);
+	for (int s = 0; s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		offset = AlignOffset(offset);
+		table[s].id = data[s].id;
+		table[s].elementSize = data[s].elementSize;
+		table[s].offset = offset;
+		table[s].bytes = data[s].bytes;
+		offset += data[s].bytes;
+	}
+
+	FILE *file;
+#ifdef _MSC_VER
+	if (fopen_s(&file, fileName, "wb") != 0)
+		file = NULL;
+#else
+	file = fopen(fileName, "wb");
+#endif
+	if (file == NULL)
+		return false;
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		fwrite(table, sizeof(table), 1, file) == 1;
+	uint64_t position = sizeof(header) + sizeof(table);
+	static const char padding[SNAPSHOT_ALIGNMENT] = { 0 };
+	for (int s = 0; written && s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		size_t gap = (size_t)(table[s].offset - position);
+		written = (gap == 0 || fwrite(padding, 1, gap, file) == gap) &&
+			(data[s].bytes == 0 || fwrite(data[s].data, 1, (size_t)data[s].bytes, file) == data[s].bytes);
+		position = table[s].offset + table[s].bytes;
+	}
+	written = (fclose(file) == 0) && written;
+	return written;
+}
+
+/* Replace the parameterized world's stars and counters with those of */
+/* the parameterized snapshot. Returns false, leaving the world as it */
+/* was, if the file is missing, does not describe a valid world, or   */
+/* was saved with other collision stages than the world's.            */
+bool LoadSnapshot(const char *fileName, StarWorld &world)
+{
+	StarMappedFile mapping;
+	if (!mapping.Open(fileName) || mapping.Size() < sizeof(SnapshotHeader) + sizeof(SnapshotSection) * NBR_SNAPSHOT_SECTIONS)
+		return false;
+	SnapshotHeader header;
+	memcpy(&header, mapping.Data(), sizeof(header));
+	if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION ||
+		header.nbrSections != NBR_SNAPSHOT_SECTIONS || header.headerSize != sizeof(SnapshotHeader) ||
+		header.nbrStars < 1 || header.nbrStars > MAX_STARS || !(header.tickSeconds > 0.0f) ||
+		header.broadPhase < BROAD_PHASE_BRUTE_FORCE || header.broadPhase > BROAD_PHASE_SWEEP ||
+		header.collisionMode < COLLISION_DISCRETE || header.collisionMode > COLLISION_CONTINUOUS ||
+		header.stageChecksum != world.stages.Checksum())
+		return false;
+
+	// Check the whole table against the world's arrays before touching them. //
+	SnapshotSection table[NBR_SNAPSHOT_SECTIONS];
+	memcpy(table, mapping.Data() + sizeof(header), sizeof(table));
+	SectionData data[NBR_SNAPSHOT_SECTIONS];
+	ListSections(world, data);
+	for (int s = 0; s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		if (table[s].id != (uint32_t)data[s].id || table[s].elementSize != data[s].elementSize ||
+			table[s].offset % SNAPSHOT_ALIGNMENT != 0 ||
+			table[s].bytes != (uint64_t)header.nbrStars * data[s].perStar * data[s].elementSize ||
+			table[s].offset > mapping.Size() || table[s].bytes > mapping.Size() - table[s].offset)
+			return false;
+	}
+
+	// Every stage must be one the table has. //
+	int lastStage = world.stages.LastStage();
+	for (int s = 0; s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		if (table[s].id != SECTION_STAGE)
+			continue;
+		const unsigned char *stages = mapping.Data() + table[s].offset;
+		for (int i = 0; i < header.nbrStars; i++)
+		{
+			int stage;
+			memcpy(&stage, stages + i * sizeof(int), sizeof(int));
+			if (stage < 0 || stage > lastStage)
+				return false;
+		}
+	}
+
+	world.Allocate(header.nbrStars);
+	ListSections(world, data);
+	for (int s = 0; s < NBR_SNAPSHOT_SECTIONS; s++)
+	{
+		if (data[s].bytes > 0)
+			memcpy(data[s].data, mapping.Data() + table[s].offset, (size_t)data[s].bytes);
+	}
+
+	world.seed = header.seed;
+	world.tickCount = (unsigned long)header.tickCount;
+	world.startTime = header.startTime;
+	world.tickSeconds = header.tickSeconds;
+	world.windowWidth = header.windowWidth;
+	world.windowHeight = header.windowHeight;
+	world.broadPhase = (BroadPhase)header.broadPhase;
+	world.collisionMode = (CollisionMode)header.collisionMode;
+	world.TOTAL_COLLISIONS = header.totalCollisions;
+	world.YELLOW_STARS = header.yellowStars;
+	world.CallInc = header.callInc;
+	world.GAME_SECONDS = header.gameSeconds;
+	world.gameOver = header.gameOver != 0;
+	world.StateChanged();
+	return true;
+}
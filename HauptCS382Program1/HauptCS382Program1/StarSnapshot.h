@@ -0,0 +1,85 @@
+/***********************************************************************/
+/* Filename: StarSnapshot.h                                            */
+/* Whole-world snapshots for warm starts. The file is laid out for    */
+/* mapping: a SnapshotHeader with the game counters, a table of       */
+/* SnapshotSections, then each per-star array exactly as it sits in   */
+/* memory, starting on a 64-byte boundary. Restoring maps the file    */
+/* and copies each section straight into the world's arrays, so a     */
+/* million stars come back in a few tens of milliseconds.             */
+/*                                                                     */
+/* Snapshots are native-endian; they move between machines of the     */
+/* same kind only.                                                    */
+/***********************************************************************/
+
+#ifndef STAR_SNAPSHOT_H
+#define STAR_SNAPSHOT_H
+
+#include <cstdint>
+#include "StarWorld.h"
+
+const uint32_t SNAPSHOT_MAGIC = 0x4E535453;   // "STSN" in a little-endian file. //
+const uint16_t SNAPSHOT_VERSION = 5;
+const int      SNAPSHOT_ALIGNMENT = 64;       // Every section starts on a multiple of this. //
+
+// The per-star arrays, in file order. //
+enum SnapshotSectionId
+{
+	SECTION_X = 1,
+	SECTION_Y,
+	SECTION_PREV_X,
+	SECTION_PREV_Y,
+	SECTION_X_INC,
+	SECTION_Y_INC,
+	SECTION_SPIN,
+	SECTION_SPIN_INC,
+	SECTION_SPIN_COS,
+	SECTION_SPIN_SIN,
+	SECTION_PULSATION,
+	SECTION_PULSATION_INC,
+	SECTION_RADIUS,
+	SECTION_FREEZE_LIMIT,
+	SECTION_FREEZE_DEADLINE,
+	SECTION_COLLISION_CNT,
+	SECTION_COLOR,
+	SECTION_STAGE,
+	SECTION_BASE_PULSATION_INC,
+	SECTION_BASE_SPIN_INC,
+	NBR_SNAPSHOT_SECTIONS = SECTION_BASE_SPIN_INC
+};
+
+struct SnapshotHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t nbrSections;
+	uint32_t headerSize;              // sizeof(SnapshotHeader). //
+	int32_t  nbrStars;
+
+	uint64_t seed;
+	uint64_t tickCount;
+	uint64_t totalCollisions;
+	double   startTime;
+	float    tickSeconds;
+	float    windowWidth;
+	float    windowHeight;
+	int32_t  broadPhase;
+	int32_t  yellowStars;
+	int32_t  callInc;
+	int32_t  gameSeconds;
+	int32_t  gameOver;
+	int32_t  collisionMode;
+	uint32_t stageChecksum;           // StarStageTable::Checksum() of the stages in use. //
+};
+
+struct SnapshotSection
+{
+	uint32_t id;                      // SnapshotSectionId. //
+	uint32_t elementSize;             // Bytes per element; a star may have several. //
+	uint64_t offset;                  // From the start of the file. //
+	uint64_t bytes;
+};
+
+bool SaveSnapshot(const char *fileName, const StarWorld &world);
+bool LoadSnapshot(const char *fileName, StarWorld &world);
+
+#endif
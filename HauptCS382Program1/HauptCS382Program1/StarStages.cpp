@@ -0,0 +1,98 @@
+/***********************************************************************/
+/* Filename: StarStages.cpp                                            */
+/* Collision stage table: built-in stages and stage files.            */
+/***********************************************************************/
+
+#include "StarStages.h"
+#include <cstdio>
+#include <cstring>			// Header File For memset()
+using namespace std;
+
+// The game's stages: fresh, then one per collision up to yellow. //
+const StarStage DEFAULT_STAGES[] = {
+	{ { 0.4f, 0.9f, 0.9f }, 1.00f, 1.00f, 1.00f },   // cyan: fresh                                    //
+	{ { 0.4f, 0.4f, 0.9f }, 0.80f, 0.80f, 1.20f },   // blue: fast pulsation and spin, medium small    //
+	{ { 0.9f, 0.0f, 0.6f }, 0.70f, 0.70f, 1.15f },   // violet: medium fast, medium radius             //
+	{ { 0.9f, 0.4f, 0.4f }, 0.85f, 0.85f, 1.20f },   // red: medium, medium large radius               //
+	{ { 0.9f, 0.7f, 0.4f }, 0.80f, 0.80f, 1.15f },   // orange: medium low, large radius               //
+	{ { 0.9f, 0.9f, 0.4f }, 0.50f, 0.50f, 1.50f }    // yellow: low pulsation and spin, very large     //
+};
+
+
+StarStageTable::StarStageTable()
+{
+	Set(DEFAULT_STAGES, (int)(sizeof(DEFAULT_STAGES) / sizeof(DEFAULT_STAGES[0])));
+}
+
+/* Replace the table with the parameterized stages, fresh first.    */
+/* Returns false, leaving the table as it was, unless there are 2 to */
+/* MAX_STAGES stages with positive scales.                          */
+bool StarStageTable::Set(const StarStage *stages, int count)
+{
+	if (count < 2 || count > MAX_STAGES)
+		return false;
+	for (int s = 0; s < count; s++)
+		if (!(stages[s].pulsationScale > 0.0f && stages[s].spinScale > 0.0f && stages[s].radiusScale > 0.0f))
+			return false;
+
+	// Running products in double, rounded once per stage. //
+	double pulsation = 1.0;
+	double spin = 1.0;
+	double size = 1.0;
+	for (int s = 0; s < count; s++)
+	{
+		pulsation *= stages[s].pulsationScale;
+		spin *= stages[s].spinScale;
+		size *= stages[s].radiusScale;
+		red[s] = stages[s].color[0];
+		green[s] = stages[s].color[1];
+		blue[s] = stages[s].color[2];
+		pulsationFactor[s] = (float)pulsation;
+		spinFactor[s] = (float)spin;
+		radiusFactor[s] = (float)size;
+	}
+	nbrStages = count;
+
+	// FNV-1a over the stages as given. //
+	checksum = 2166136261u;
+	const unsigned char *bytes = (const unsigned char *)stages;
+	for (size_t b = 0; b < count * sizeof(StarStage); b++)
+		checksum = (checksum ^ bytes[b]) * 16777619u;
+	return true;
+}
+
+/* Replace the table with the stages in the named file. Returns false, */
+/* leaving the table as it was, if the file cannot be read or does not */
+/* describe a valid table.                                             */
+bool StarStageTable::Load(const char *fileName)
+{
+	FILE *file;
+#ifdef _MSC_VER
+	if (fopen_s(&file, fileName, "r") != 0)
+		file = NULL;
+#else
+	file = fopen(fileName, "r");
+#endif
+	if (file == NULL)
+		return false;
+
+	StarStage stages[MAX_STAGES + 1];
+	memset(stages, 0, sizeof(stages));
+	int count = 0;
+	bool valid = true;
+	char line[256];
+	while (valid && fgets(line, sizeof(line), file) != NULL)
+	{
+		const char *text = line;
+		while (*text == ' ' || *text == '\t')
+			text++;
+		if (*text == '#' || *text == '\n' || *text == '\r' || *text == '\0')
+			continue;
+		StarStage &stage = stages[count < MAX_STAGES ? count : MAX_STAGES];
+		valid = sscanf(text, "%f %f %f %f %f %f", &stage.color[0], &stage.color[1], &stage.color[2],
+			&stage.pulsationScale, &stage.spinScale, &stage.radiusScale) == 6;
+		count++;
+	}
+	fclose(file);
+	return valid && Set(stages, count);
+}
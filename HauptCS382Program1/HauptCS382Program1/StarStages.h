@@ -0,0 +1,57 @@
+/***********************************************************************/
+/* Filename: StarStages.h                                              */
+/* The collision stages a star passes through. Each stage has a color */
+/* and scales the star's pulsation rate, spin rate and radius on     */
+/* entry; the table keeps the running products of those scales, so a */
+/* star at any stage is one lookup away from its rates and radius,    */
+/* however it got there, and no rounding builds up stage by stage.    */
+/*                                                                     */
+/* A stage file holds one stage per line, fresh stars' stage first:   */
+/*     red green blue pulsation-scale spin-scale radius-scale          */
+/* Blank lines and lines starting with '#' are skipped. The last      */
+/* stage is the yellow one: the game is over once every star is in it.*/
+/***********************************************************************/
+
+#ifndef STAR_STAGES_H
+#define STAR_STAGES_H
+
+#include <cstdint>
+
+const int MAX_STAGES = 16;                      // Most stages a table may hold. //
+
+// One stage, as written in a stage file. //
+struct StarStage
+{
+	float color[3];
+	float pulsationScale;             // Multiplies the rates on entering the stage. //
+	float spinScale;
+	float radiusScale;
+};
+
+class StarStageTable
+{
+public:
+	// Per stage, the star's state on reaching it: color, and rates //
+	// and radius as multiples of the star's own fresh ones.        //
+	float red[MAX_STAGES];
+	float green[MAX_STAGES];
+	float blue[MAX_STAGES];
+	float pulsationFactor[MAX_STAGES];
+	float spinFactor[MAX_STAGES];
+	float radiusFactor[MAX_STAGES];
+
+	StarStageTable();                 // The game's own five stages past fresh. //
+
+	bool Set(const StarStage *stages, int count);
+	bool Load(const char *fileName);
+
+	int NbrStages() const { return nbrStages; }
+	int LastStage() const { return nbrStages - 1; }
+	uint32_t Checksum() const { return checksum; }
+
+private:
+	int nbrStages;
+	uint32_t checksum;                // Identifies the table, so replays can insist on it. //
+};
+
+#endif
@@ -0,0 +1,70 @@
+/***********************************************************************/
+/* Filename: StarSweep.cpp                                             */
+/* Sort-and-sweep broad phase for star collisions.                    */
+/***********************************************************************/
+
+#include "StarSweep.h"
+#include <algorithm>
+using namespace std;
+
+
+StarSweep::StarSweep()
+{
+	maxReach = 0.0f;
+	nbrSorted = 0;
+}
+
+/* Forget the saved order, e.g. after the star population is replaced. */
+void StarSweep::Invalidate()
+{
+	nbrSorted = 0;
+}
+
+/* Sort the parameterized stars along x, copying their centers and */
+/* collision reaches into slot order for the sweep.                 */
+void StarSweep::Build(const float *x, const float *y, const float *reach, int nbrStars)
+{
+	if (nbrSorted != nbrStars)
+	{
+		// No usable previous order: sort from scratch. //
+		slotStar.resize(nbrStars);
+		for (int i = 0; i < nbrStars; i++)
+			slotStar[i] = i;
+		sort(slotStar.begin(), slotStar.end(),
+			[x](int a, int b) { return x[a] < x[b]; });
+		nbrSorted = nbrStars;
+	}
+	else
+	{
+		// Last pass's order is nearly sorted still; insertion sort //
+		// fixes it up in close to linear time.                     //
+		for (int k = 1; k < nbrStars; k++)
+		{
+			int star = slotStar[k];
+			float key = x[star];
+			int j = k - 1;
+			while (j >= 0 && x[slotStar[j]] > key)
+			{
+				slotStar[j + 1] = slotStar[j];
+				j--;
+			}
+			slotStar[j + 1] = star;
+		}
+	}
+
+	slotX.resize(nbrStars);
+	slotY.resize(nbrStars);
+	slotReach.resize(nbrStars);
+	starSlot.resize(nbrStars);
+	maxReach = 0.0f;
+	for (int k = 0; k < nbrStars; k++)
+	{
+		int star = slotStar[k];
+		slotX[k] = x[star];
+		slotY[k] = y[star];
+		slotReach[k] = reach[star];
+		starSlot[star] = k;
+		if (reach[star] > maxReach)
+			maxReach = reach[star];
+	}
+}
@@ -0,0 +1,34 @@
+/***********************************************************************/
+/* Filename: StarSweep.h                                               */
+/* Sort-and-sweep broad phase for star collisions. Stars are kept     */
+/* sorted along x; since they move only a little per tick, the order  */
+/* from the previous pass is repaired with an insertion sort instead  */
+/* of being sorted from scratch.                                       */
+/***********************************************************************/
+
+#ifndef STAR_SWEEP_H
+#define STAR_SWEEP_H
+
+#include <vector>
+
+class StarSweep
+{
+public:
+	float maxReach;                   // Largest collision reach of any star. //
+
+	std::vector<int>   slotStar;      // Star index in each slot, in increasing x. //
+	std::vector<float> slotX;         // Star center in each slot.                 //
+	std::vector<float> slotY;
+	std::vector<float> slotReach;     // Collision reach of the star in each slot. //
+	std::vector<int>   starSlot;      // Slot holding each star.                   //
+
+	StarSweep();
+
+	void Build(const float *x, const float *y, const float *reach, int nbrStars);
+	void Invalidate();
+
+private:
+	int nbrSorted;                    // # stars the saved order covers (0 = none). //
+};
+
+#endif
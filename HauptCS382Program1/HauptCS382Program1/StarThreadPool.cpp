@@ -0,0 +1,201 @@
+/***********************************************************************/
+/* Filename: StarThreadPool.cpp                                        */
+/* Work-stealing loop runner used to spread the tick over cores.       */
+/***********************************************************************/
+
+#include "StarThreadPool.h"
+#include <new>
+using namespace std;
+
+
+/* Pack a chunk range into one word: begin high, end low. */
+static unsigned long long PackRange(unsigned int begin, unsigned int end)
+{
+	return ((unsigned long long)begin << 32) | end;
+}
+
+static unsigned int RangeBegin(unsigned long long range) { return (unsigned int)(range >> 32); }
+static unsigned int RangeEnd(unsigned long long range)   { return (unsigned int)range; }
+
+
+/* Start the workers; the calling thread is the last of the threads. */
+StarThreadPool::StarThreadPool(int threadCount)
+{
+	nbrThreads = threadCount < 1 ? 1 : (threadCount > MAX_POOL_THREADS ? MAX_POOL_THREADS : threadCount);
+
+	// A plain new[] need not honor the ranges' cache-line alignment //
+	// before C++17, so they are placed on a line boundary by hand.   //
+	size_t space = (nbrThreads + 1) * sizeof(ChunkRange);
+	rangeStorage.reset(new char[space]);
+	void *base = rangeStorage.get();
+	ranges = (ChunkRange *)align(alignof(ChunkRange), nbrThreads * sizeof(ChunkRange), base, space);
+	for (int t = 0; t < nbrThreads; t++)
+	{
+		new (&ranges[t]) ChunkRange;
+		ranges[t].range.store(0);
+	}
+	function = NULL;
+	context = NULL;
+	count = 0;
+	chunkSize = 1;
+	generation = 0;
+	loopReady = true;
+	stopping = false;
+	activeWorkers.store(0);
+	pendingChunks.store(0);
+	steals.store(0);
+	for (int t = 0; t < nbrThreads - 1; t++)
+		workers.push_back(thread(&StarThreadPool::WorkerLoop, this, t));
+}
+
+/* Wake the workers one last time so they exit, and wait for them. */
+StarThreadPool::~StarThreadPool()
+{
+	{
+		lock_guard<mutex> lock(wakeMutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (size_t t = 0; t < workers.size(); t++)
+		workers[t].join();
+}
+
+/* Run the parameterized function over items 0 through count - 1, in  */
+/* chunks of chunkSize items, on every thread of the pool, and return */
+/* once all of them are done. Loops too small to split run inline.    */
+void StarThreadPool::ParallelFor(int itemCount, int itemsPerChunk, ChunkFunction chunkFunction, void *chunkContext)
+{
+	if (itemCount <= 0)
+		return;
+	if (itemsPerChunk < 1)
+		itemsPerChunk = 1;
+	int nbrChunks = (itemCount + itemsPerChunk - 1) / itemsPerChunk;
+	if (nbrThreads <= 1 || nbrChunks <= 1)
+	{
+		chunkFunction(chunkContext, 0, itemCount);
+		return;
+	}
+
+	// A worker that woke too late for the last loop may still be  //
+	// looking over the (empty) ranges; let it finish before they   //
+	// are refilled, and keep any other from starting meanwhile.    //
+	{
+		lock_guard<mutex> lock(wakeMutex);
+		loopReady = false;
+	}
+	while (activeWorkers.load() > 0)
+		this_thread::yield();
+
+	// Every thread starts with a contiguous, even share of the chunks. //
+	function = chunkFunction;
+	context = chunkContext;
+	count = itemCount;
+	chunkSize = itemsPerChunk;
+	pendingChunks.store(nbrChunks);
+	for (int t = 0; t < nbrThreads; t++)
+	{
+		unsigned int begin = (unsigned int)((long long)nbrChunks * t / nbrThreads);
+		unsigned int end = (unsigned int)((long long)nbrChunks * (t + 1) / nbrThreads);
+		ranges[t].range.store(PackRange(begin, end));
+	}
+	{
+		lock_guard<mutex> lock(wakeMutex);
+		generation++;
+		loopReady = true;
+	}
+	wake.notify_all();
+
+	// The caller runs chunks like any worker, and then waits only for //
+	// the chunks other threads are still in the middle of, not for    //
+	// workers that have yet to wake.                                  //
+	RunChunks(nbrThreads - 1);
+	while (pendingChunks.load() > 0)
+		this_thread::yield();
+}
+
+/* Worker body: wait for each new loop and help run it. A worker that */
+/* wakes after the loop is over finds every range empty and goes back */
+/* to sleep.                                                          */
+void StarThreadPool::WorkerLoop(int self)
+{
+	unsigned long seen = 0;
+	for (;;)
+	{
+		{
+			unique_lock<mutex> lock(wakeMutex);
+			while (!stopping && (generation == seen || !loopReady))
+				wake.wait(lock);
+			if (stopping)
+				return;
+			seen = generation;
+			activeWorkers.fetch_add(1);
+		}
+		RunChunks(self);
+		activeWorkers.fetch_sub(1);
+	}
+}
+
+/* Run the indexed thread's own chunks, then stolen ones, until no */
+/* thread has any chunks left to hand out.                         */
+void StarThreadPool::RunChunks(int self)
+{
+	int chunk;
+	do
+	{
+		while (TakeChunk(self, chunk))
+		{
+			int first = chunk * chunkSize;
+			int last = (count - first < chunkSize) ? count : first + chunkSize;
+			function(context, first, last);
+			pendingChunks.fetch_sub(1);
+		}
+	} while (StealChunks(self));
+}
+
+/* Take the next chunk from the front of the indexed thread's range. */
+bool StarThreadPool::TakeChunk(int self, int &chunk)
+{
+	unsigned long long range = ranges[self].range.load();
+	while (RangeBegin(range) < RangeEnd(range))
+	{
+		if (ranges[self].range.compare_exchange_weak(range, PackRange(RangeBegin(range) + 1, RangeEnd(range))))
+		{
+			chunk = (int)RangeBegin(range);
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Move the back half of the fullest other range into the indexed */
+/* thread's (empty) range; returns false once every range is empty. */
+bool StarThreadPool::StealChunks(int self)
+{
+	for (;;)
+	{
+		int victim = -1;
+		unsigned long long victimRange = 0;
+		unsigned int most = 0;
+		for (int t = 0; t < nbrThreads; t++)
+		{
+			unsigned long long range = ranges[t].range.load();
+			unsigned int left = RangeEnd(range) > RangeBegin(range) ? RangeEnd(range) - RangeBegin(range) : 0;
+			if (t != self && left > most)
+			{
+				victim = t;
+				victimRange = range;
+				most = left;
+			}
+		}
+		if (victim < 0)
+			return false;
+
+		unsigned int split = RangeEnd(victimRange) - (most + 1) / 2;
+		if (ranges[victim].range.compare_exchange_strong(victimRange, PackRange(RangeBegin(victimRange), split)))
+		{
+			ranges[self].range.store(PackRange(split, RangeEnd(victimRange)));
+			steals.fetch_add(1);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,80 @@
+/***********************************************************************/
+/* Filename: StarThreadPool.h                                          */
+/* Fixed pool of worker threads that runs one loop over a range of    */
+/* stars at a time, split into chunks. Each thread (the caller        */
+/* included) starts with an even share of the chunks and works        */
+/* through them from the front; a thread that runs out steals half of */
+/* the chunks left to whichever other thread has the most. The caller */
+/* returns as soon as every chunk is done; it never waits for a       */
+/* worker that found nothing left to run. Chunks must be independent */
+/* of each other, so the result does not depend on which thread ran  */
+/* which chunk.                                                        */
+/***********************************************************************/
+
+#ifndef STAR_THREAD_POOL_H
+#define STAR_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const int MAX_POOL_THREADS = 256;                     // Largest supported thread count. //
+
+// Processes items first through last - 1 of a loop. //
+typedef void (*ChunkFunction)(void *context, int first, int last);
+
+class StarThreadPool
+{
+public:
+	/* The parameterized count includes the calling thread, so a pool */
+	/* of one (or less) runs every loop inline without any workers.   */
+	StarThreadPool(int threadCount = 1);
+	~StarThreadPool();
+
+	int  ThreadCount() const { return nbrThreads; }
+	void ParallelFor(int count, int chunkSize, ChunkFunction function, void *context);
+
+	unsigned long Steals() const { return steals.load(); }
+
+private:
+	// Chunks [begin, end) still to run, packed so both ends move with //
+	// one compare-and-swap: the owner takes from the front, thieves  //
+	// from the back. Each range has a cache line to itself.          //
+	struct alignas(64) ChunkRange
+	{
+		std::atomic<unsigned long long> range;
+	};
+
+	int nbrThreads;
+	std::unique_ptr<char[]> rangeStorage;     // Room for the ranges plus alignment slack. //
+	ChunkRange *ranges;                       // One per thread, in rangeStorage; the caller's is last. //
+	std::vector<std::thread> workers;
+
+	// The loop being run. //
+	ChunkFunction function;
+	void *context;
+	int  count;
+	int  chunkSize;
+
+	std::mutex wakeMutex;
+	std::condition_variable wake;
+	unsigned long generation;         // Bumped for each loop handed to the workers. //
+	bool loopReady;                   // Cleared while the next loop is being set up. //
+	bool stopping;
+	std::atomic<int> activeWorkers;   // Workers inside RunChunks. //
+	std::atomic<int> pendingChunks;   // Chunks of the current loop not yet finished. //
+	std::atomic<unsigned long> steals;
+
+	void WorkerLoop(int self);
+	void RunChunks(int self);
+	bool TakeChunk(int self, int &chunk);
+	bool StealChunks(int self);
+
+	StarThreadPool(const StarThreadPool &);
+	StarThreadPool &operator=(const StarThreadPool &);
+};
+
+#endif
@@ -0,0 +1,144 @@
+/***********************************************************************/
+/* Filename: StarTimerWheel.cpp                                        */
+/* Hierarchical timer wheel for per-star deadlines.                   */
+/***********************************************************************/
+
+#include "StarTimerWheel.h"
+using namespace std;
+
+
+StarTimerWheel::StarTimerWheel()
+{
+	Reset(0, 0);
+}
+
+/* Drop every timer and size the wheel for the parameterized number  */
+/* of timers; the next tick to be processed follows the parameterized */
+/* current tick.                                                      */
+void StarTimerWheel::Reset(int nbrTimers, unsigned long currentTick)
+{
+	nextTick = currentTick + 1;
+	nbrPending = 0;
+	slotHead.assign(WHEEL_LEVELS * WHEEL_SLOTS, -1);
+	timerNext.assign(nbrTimers, -1);
+	timerPrev.assign(nbrTimers, -1);
+	timerSlot.assign(nbrTimers, -1);
+	timerDeadline.assign(nbrTimers, 0);
+}
+
+/* Have the indexed timer expire on the parameterized tick, replacing */
+/* any deadline it had. A deadline already past expires on the next   */
+/* tick processed.                                                    */
+void StarTimerWheel::Schedule(int timer, unsigned long deadline)
+{
+	if (timerSlot[timer] >= 0)
+		Unlink(timer);
+	else
+		nbrPending++;
+	timerDeadline[timer] = deadline;
+	Link(timer);
+}
+
+/* Stop the indexed timer, if it is scheduled. */
+void StarTimerWheel::Cancel(int timer)
+{
+	if (timerSlot[timer] < 0)
+		return;
+	Unlink(timer);
+	nbrPending--;
+}
+
+/* Process every tick up to and including the parameterized one,    */
+/* appending the timers that expire to the parameterized list. They */
+/* come out in no particular order within a tick.                   */
+void StarTimerWheel::Advance(unsigned long tick, vector<int> &expired)
+{
+	while (nextTick <= tick)
+	{
+		// Nothing to expire or cascade: skip straight to the end. //
+		if (nbrPending == 0)
+		{
+			nextTick = tick + 1;
+			return;
+		}
+
+		unsigned long current = nextTick;
+		int slot = (int)(current & (WHEEL_SLOTS - 1));
+
+		// Level 0 has wrapped: refill it from the next level up, and //
+		// that level from the one above it if it has wrapped too.    //
+		if (slot == 0)
+		{
+			for (int level = 1; level < WHEEL_LEVELS && Cascade(level, current); level++)
+				;
+		}
+
+		while (slotHead[slot] >= 0)
+		{
+			int timer = slotHead[slot];
+			Unlink(timer);
+			nbrPending--;
+			expired.push_back(timer);
+		}
+		nextTick = current + 1;
+	}
+}
+
+/* File the indexed timer in the finest level whose span covers its */
+/* deadline, measured from the next tick to be processed.           */
+void StarTimerWheel::Link(int timer)
+{
+	unsigned long deadline = timerDeadline[timer];
+	if (deadline < nextTick)
+		deadline = nextTick;
+	unsigned long delta = deadline - nextTick;
+
+	int level = 0;
+	while (level < WHEEL_LEVELS - 1 && delta >= (1UL << (WHEEL_SLOT_BITS * (level + 1))))
+		level++;
+
+	// Too far ahead even for the top level: park the timer in the //
+	// top level's farthest slot, to be re-filed when it cascades.  //
+	unsigned long horizon = 1UL << (WHEEL_SLOT_BITS * WHEEL_LEVELS);
+	if (delta >= horizon)
+		deadline = nextTick + horizon - 1;
+
+	int slot = level * WHEEL_SLOTS + (int)((deadline >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1));
+	timerSlot[timer] = slot;
+	timerPrev[timer] = -1;
+	timerNext[timer] = slotHead[slot];
+	if (slotHead[slot] >= 0)
+		timerPrev[slotHead[slot]] = timer;
+	slotHead[slot] = timer;
+}
+
+/* Remove the indexed timer from its slot's list. */
+void StarTimerWheel::Unlink(int timer)
+{
+	int slot = timerSlot[timer];
+	if (timerPrev[timer] >= 0)
+		timerNext[timerPrev[timer]] = timerNext[timer];
+	else
+		slotHead[slot] = timerNext[timer];
+	if (timerNext[timer] >= 0)
+		timerPrev[timerNext[timer]] = timerPrev[timer];
+	timerSlot[timer] = -1;
+}
+
+/* Re-file every timer in the parameterized level's slot for the     */
+/* parameterized tick into the finer levels. Returns true if that    */
+/* slot was the level's first, i.e. the level above has wrapped too. */
+bool StarTimerWheel::Cascade(int level, unsigned long tick)
+{
+	int index = (int)((tick >> (WHEEL_SLOT_BITS * level)) & (WHEEL_SLOTS - 1));
+	int slot = level * WHEEL_SLOTS + index;
+	int timer = slotHead[slot];
+	slotHead[slot] = -1;
+	while (timer >= 0)
+	{
+		int next = timerNext[timer];
+		Link(timer);
+		timer = next;
+	}
+	return index == 0;
+}
@@ -0,0 +1,52 @@
+/***********************************************************************/
+/* Filename: StarTimerWheel.h                                          */
+/* Hierarchical timer wheel for per-star deadlines, counted in ticks. */
+/* Level 0 has a slot for each of the next WHEEL_SLOTS ticks; each    */
+/* further level has slots WHEEL_SLOTS times as wide. A timer sits in */
+/* the finest level whose span reaches its deadline and is moved down */
+/* a level each time the wheel below wraps around, so a tick touches  */
+/* only the timers that expire in it plus, now and then, one slot of  */
+/* timers being cascaded. Scheduling and cancelling take constant     */
+/* time, however many timers are pending.                             */
+/***********************************************************************/
+
+#ifndef STAR_TIMER_WHEEL_H
+#define STAR_TIMER_WHEEL_H
+
+#include <vector>
+
+const int WHEEL_SLOT_BITS = 6;
+const int WHEEL_SLOTS = 1 << WHEEL_SLOT_BITS;   // Slots per level. //
+const int WHEEL_LEVELS = 4;                     // Reaches 2^24 ticks ahead; later deadlines are re-filed. //
+
+class StarTimerWheel
+{
+public:
+	StarTimerWheel();
+
+	void Reset(int nbrTimers, unsigned long currentTick);
+	void Schedule(int timer, unsigned long deadline);
+	void Cancel(int timer);
+	void Advance(unsigned long tick, std::vector<int> &expired);
+
+	int  Pending() const { return nbrPending; }
+	bool Scheduled(int timer) const { return timerSlot[timer] >= 0; }
+
+private:
+	unsigned long nextTick;           // Earliest tick not yet processed. //
+	int nbrPending;                   // # timers scheduled.              //
+
+	// Each slot is a doubly-linked list threaded through the per-timer //
+	// arrays, so any timer can be unlinked without a search.           //
+	std::vector<int> slotHead;        // First timer in each slot, or -1; level by level. //
+	std::vector<int> timerNext;       // Next timer in the same slot, or -1.              //
+	std::vector<int> timerPrev;       // Previous timer in the same slot, or -1.          //
+	std::vector<int> timerSlot;       // Slot holding each timer, or -1 if not scheduled. //
+	std::vector<unsigned long> timerDeadline;
+
+	void Link(int timer);
+	void Unlink(int timer);
+	bool Cascade(int level, unsigned long tick);
+};
+
+#endif
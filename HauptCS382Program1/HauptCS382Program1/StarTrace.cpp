@@ -0,0 +1,196 @@
+/***********************************************************************/
+/* Filename: StarTrace.cpp                                             */
+/* Compact binary event trace with bounded file rotation.             */
+/***********************************************************************/
+
+#include "StarTrace.h"
+#include <cstring>
+using namespace std;
+
+
+/* Name of the parameterized event type, for the dump tool. */
+const char *TraceEventName(int type)
+{
+	switch (type)
+	{
+	case TRACE_COLLISION:    return "collision";
+	case TRACE_FREEZE:       return "freeze";
+	case TRACE_UNFREEZE:     return "unfreeze";
+	case TRACE_STAGE_CHANGE: return "stage";
+	case TRACE_GAME_OVER:    return "gameover";
+	}
+	return "unknown";
+}
+
+
+StarTrace::StarTrace()
+{
+	maxFileBytes = DEFAULT_TRACE_FILE_BYTES;
+	maxFiles = DEFAULT_TRACE_FILES;
+	file = NULL;
+	fileBytes = 0;
+	fileIndex = 0;
+	current.resize(TRACE_BUFFER_RECORDS);
+	nbrCurrent = 0;
+	dropped = 0;
+	running = false;
+}
+
+StarTrace::~StarTrace()
+{
+	Close();
+}
+
+/* Start tracing to the named file. Once it holds maxFileBytes it is  */
+/* renamed to name.1 (name.1 to name.2, and so on) and a fresh file   */
+/* is started, so at most maxFiles files ever exist.                  */
+bool StarTrace::Open(const char *fileName, long maxBytes, int nbrFiles)
+{
+	Close();
+	baseName = fileName;
+	maxFileBytes = maxBytes > (long)sizeof(TraceHeader) ? maxBytes : (long)sizeof(TraceHeader) + 1;
+	maxFiles = nbrFiles > 0 ? nbrFiles : 1;
+	fileIndex = 0;
+	if (!Rotate())
+		return false;
+
+	for (int b = 0; b < TRACE_SPARE_BUFFERS; b++)
+		spare.push_back(vector<TraceRecord>(TRACE_BUFFER_RECORDS));
+	running = true;
+	writer = thread(&StarTrace::WriterLoop, this);
+	return true;
+}
+
+/* Write out everything recorded so far and close the file. */
+void StarTrace::Close()
+{
+	if (!running)
+		return;
+	HandOff();
+	{
+		lock_guard<mutex> lock(queueMutex);
+		running = false;
+	}
+	wake.notify_one();
+	writer.join();
+
+	if (file != NULL)
+		fclose(file);
+	file = NULL;
+	spare.clear();
+	if (dropped > 0)
+		fprintf(stderr, "trace: %lu records dropped (trace closed)\n", dropped);
+}
+
+/* Pass the filled buffer to the writer and carry on with a spare one. */
+/* If every spare is still queued for writing, wait for the writer to  */
+/* recycle one: the trace runs on its own event thread, so this holds  */
+/* back the events rather than losing them. Records made while the     */
+/* trace is closed are lost.                                           */
+void StarTrace::HandOff()
+{
+	if (nbrCurrent == 0)
+		return;
+	{
+		unique_lock<mutex> lock(queueMutex);
+		recycled.wait(lock, [this] { return !spare.empty() || !running; });
+		if (!running)
+			dropped += nbrCurrent;
+		else
+		{
+			current.resize(nbrCurrent);
+			full.push_back(vector<TraceRecord>());
+			full.back().swap(current);
+			current.swap(spare.back());
+			spare.pop_back();
+			current.resize(TRACE_BUFFER_RECORDS);
+		}
+	}
+	nbrCurrent = 0;
+	wake.notify_one();
+}
+
+/* Background writer: write each full buffer, then recycle it. */
+void StarTrace::WriterLoop()
+{
+	unique_lock<mutex> lock(queueMutex);
+	for (;;)
+	{
+		wake.wait(lock, [this] { return !full.empty() || !running; });
+		if (full.empty())
+			return;
+
+		vector<TraceRecord> buffer;
+		buffer.swap(full.front());
+		full.pop_front();
+
+		lock.unlock();
+		WriteRecords(buffer.data(), (int)buffer.size());
+		lock.lock();
+		spare.push_back(vector<TraceRecord>());
+		spare.back().swap(buffer);
+		recycled.notify_one();
+	}
+}
+
+/* Append records to the current file, rotating whenever it fills. */
+void StarTrace::WriteRecords(const TraceRecord *records, int count)
+{
+	while (count > 0 && file != NULL)
+	{
+		long room = (maxFileBytes - fileBytes) / (long)sizeof(TraceRecord);
+		if (room <= 0)
+		{
+			if (!Rotate())
+				return;
+			continue;
+		}
+		int chunk = count < room ? count : (int)room;
+		fwrite(records, sizeof(TraceRecord), chunk, file);
+		fileBytes += chunk * (long)sizeof(TraceRecord);
+		records += chunk;
+		count -= chunk;
+	}
+	if (file != NULL)
+		fflush(file);
+}
+
+/* Shift the older files down one place, dropping the oldest, and */
+/* start a new file with a fresh header.                          */
+bool StarTrace::Rotate()
+{
+	if (file != NULL)
+	{
+		fclose(file);
+		file = NULL;
+
+		string oldest = baseName + "." + to_string(maxFiles - 1);
+		remove(oldest.c_str());
+		for (int f = maxFiles - 2; f >= 0; f--)
+		{
+			string from = f == 0 ? baseName : baseName + "." + to_string(f);
+			string to = baseName + "." + to_string(f + 1);
+			if (maxFiles > 1)
+				rename(from.c_str(), to.c_str());
+		}
+	}
+
+#ifdef _MSC_VER
+	if (fopen_s(&file, baseName.c_str(), "wb") != 0)
+		file = NULL;
+#else
+	file = fopen(baseName.c_str(), "wb");
+#endif
+	if (file == NULL)
+		return false;
+
+	TraceHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = TRACE_MAGIC;
+	header.version = TRACE_VERSION;
+	header.recordSize = (uint16_t)sizeof(TraceRecord);
+	header.fileIndex = fileIndex++;
+	fwrite(&header, sizeof(header), 1, file);
+	fileBytes = (long)sizeof(header);
+	return true;
+}
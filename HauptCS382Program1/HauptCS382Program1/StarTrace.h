@@ -0,0 +1,118 @@
+/***********************************************************************/
+/* Filename: StarTrace.h                                               */
+/* Compact binary event trace. Every collision, freeze, unfreeze,     */
+/* stage change and game over is one fixed-size record, written to a  */
+/* bounded set of rotating files by a background thread. The          */
+/* StarTraceDump tool maps the files and summarizes them.             */
+/*                                                                     */
+/* File layout: a TraceHeader, then TraceRecords back to back.         */
+/***********************************************************************/
+
+#ifndef STAR_TRACE_H
+#define STAR_TRACE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Kinds of traced event. //
+enum TraceEventType
+{
+	TRACE_COLLISION = 1,              // starA ran into starB.                       //
+	TRACE_FREEZE,                     // starA frozen; value = freeze limit (sec).    //
+	TRACE_UNFREEZE,                   // starA released (click or expiry).           //
+	TRACE_STAGE_CHANGE,               // starA reached stage value.                  //
+	TRACE_GAME_OVER,                  // Every star has turned yellow.               //
+	NBR_TRACE_EVENT_TYPES
+};
+const char *TraceEventName(int type);
+
+const uint32_t TRACE_MAGIC = 0x43525453;      // "STRC" in a little-endian file. //
+const uint16_t TRACE_VERSION = 2;
+
+struct TraceHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t recordSize;              // sizeof(TraceRecord). //
+	uint32_t fileIndex;               // Sequence number of this file within the run. //
+	uint32_t reserved;
+};
+
+struct TraceRecord
+{
+	uint64_t tick;                    // Simulation tick the event happened on. //
+	int32_t  starA;
+	int32_t  starB;                   // -1 when the event involves one star. //
+	uint8_t  type;                    // TraceEventType. //
+	uint8_t  value;
+	uint16_t reserved[3];
+};
+
+const int  TRACE_BUFFER_RECORDS = 4096;               // Records handed to the writer at once. //
+const int  TRACE_SPARE_BUFFERS = 8;                   // Buffers in flight before waiting.      //
+const long DEFAULT_TRACE_FILE_BYTES = 64L << 20;      // Rotate after this many bytes.          //
+const int  DEFAULT_TRACE_FILES = 4;                   // Keep this many files in the rotation.  //
+
+class StarTrace
+{
+public:
+	StarTrace();
+	~StarTrace();
+
+	bool Open(const char *fileName, long maxFileBytes = DEFAULT_TRACE_FILE_BYTES,
+		int maxFiles = DEFAULT_TRACE_FILES);
+	void Close();
+
+	/* Append one event; cheap, and waits on the disk only when every */
+	/* buffer is still queued for writing.                            */
+	void Record(TraceEventType type, uint64_t tick, int starA, int starB = -1, int value = 0)
+	{
+		TraceRecord &record = current[nbrCurrent];
+		record.tick = tick;
+		record.starA = starA;
+		record.starB = starB;
+		record.type = (uint8_t)type;
+		record.value = (uint8_t)value;
+		record.reserved[0] = record.reserved[1] = record.reserved[2] = 0;
+		if (++nbrCurrent == TRACE_BUFFER_RECORDS)
+			HandOff();
+	}
+
+	unsigned long Dropped() const { return dropped; }
+
+private:
+	std::string baseName;
+	long  maxFileBytes;
+	int   maxFiles;
+	FILE *file;
+	long  fileBytes;                  // Bytes written to the current file. //
+	uint32_t fileIndex;
+
+	std::vector<TraceRecord> current; // Buffer being filled by the simulation. //
+	int nbrCurrent;
+	unsigned long dropped;            // Records made while the trace was closed. //
+
+	std::mutex queueMutex;            // Guards everything below. //
+	std::condition_variable wake;     // Writer: a buffer is full, or the trace is closing. //
+	std::condition_variable recycled; // Recorder: a spare buffer is free again.            //
+	std::deque<std::vector<TraceRecord> > full;   // Filled buffers (sized to their records) waiting to be written. //
+	std::vector<std::vector<TraceRecord> > spare; // Empty buffers ready for reuse. //
+	bool running;
+	std::thread writer;
+
+	void HandOff();
+	void WriterLoop();
+	void WriteRecords(const TraceRecord *records, int count);
+	bool Rotate();
+
+	StarTrace(const StarTrace &);
+	StarTrace &operator=(const StarTrace &);
+};
+
+#endif
@@ -0,0 +1,239 @@
+/***********************************************************************/
+/* Filename: StarTraceDump.cpp                                         */
+/* Summarizes binary event traces written by StarTrace. Each file is  */
+/* memory-mapped and its records are walked in place, so even the     */
+/* largest traces are read without copying.                           */
+/*                                                                     */
+/* Usage: StarTraceDump [--type NAME] [--star N] [--from TICK]         */
+/*                      [--to TICK] [--top N] [--list] FILE...         */
+/***********************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "StarMappedFile.h"
+#include "StarStages.h"
+#include "StarTrace.h"
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int DEFAULT_TOP_STARS = 10;                     // # busiest stars listed by default. //
+
+// Which records to look at. //
+struct TraceFilter
+{
+	int  type;                        // TraceEventType, or 0 for every type. //
+	long star;                        // Star that must be involved, or -1.   //
+	uint64_t fromTick;
+	uint64_t toTick;
+};
+
+// Totals over every record that passed the filter. //
+struct TraceSummary
+{
+	unsigned long records;
+	uint64_t firstTick;
+	uint64_t lastTick;
+	unsigned long typeCount[NBR_TRACE_EVENT_TYPES];
+	unsigned long stageCount[MAX_STAGES];     // Stage changes per stage reached, ... //
+	int lastStage;                            // ...up to the highest one seen.       //
+	vector<unsigned long> starCollisions;     // Collisions per star id. //
+};
+
+
+/* Print the command-line summary. */
+static void Usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [--type NAME] [--star N] [--from TICK] [--to TICK]\n"
+		"       [--top N] [--list] FILE...\n", program);
+	fprintf(stderr, "  --type NAME  only collision, freeze, unfreeze, stage or gameover records\n");
+	fprintf(stderr, "  --star N     only records involving star N\n");
+	fprintf(stderr, "  --from TICK  only records at or after TICK\n");
+	fprintf(stderr, "  --to TICK    only records at or before TICK\n");
+	fprintf(stderr, "  --top N      list the N stars with the most collisions (default %d)\n", DEFAULT_TOP_STARS);
+	fprintf(stderr, "  --list       print every matching record as well\n");
+}
+
+/* Look up an event type by name; returns 0 if the name is unknown. */
+static int ParseEventType(const char *name)
+{
+	for (int t = TRACE_COLLISION; t < NBR_TRACE_EVENT_TYPES; t++)
+		if (strcmp(name, TraceEventName(t)) == 0)
+			return t;
+	return 0;
+}
+
+static bool Matches(const TraceRecord &record, const TraceFilter &filter)
+{
+	if (filter.type != 0 && record.type != filter.type)
+		return false;
+	if (filter.star >= 0 && record.starA != filter.star && record.starB != filter.star)
+		return false;
+	return record.tick >= filter.fromTick && record.tick <= filter.toTick;
+}
+
+static void CountCollision(TraceSummary &summary, int star)
+{
+	if (star < 0)
+		return;
+	if ((size_t)star >= summary.starCollisions.size())
+		summary.starCollisions.resize(star + 1, 0);
+	summary.starCollisions[star]++;
+}
+
+/* Add the matching records of the named trace file to the summary. */
+static bool SummarizeFile(const char *fileName, const TraceFilter &filter, bool list, TraceSummary &summary)
+{
+	StarMappedFile mapped;
+	if (!mapped.Open(fileName))
+	{
+		fprintf(stderr, "%s: cannot open\n", fileName);
+		return false;
+	}
+
+	TraceHeader header;
+	if (mapped.Size() < sizeof(header))
+	{
+		fprintf(stderr, "%s: too short for a trace header\n", fileName);
+		return false;
+	}
+	memcpy(&header, mapped.Data(), sizeof(header));
+	if (header.magic != TRACE_MAGIC || header.version != TRACE_VERSION ||
+		header.recordSize != sizeof(TraceRecord))
+	{
+		fprintf(stderr, "%s: not a version %d star trace\n", fileName, TRACE_VERSION);
+		return false;
+	}
+
+	// The header keeps the records 8-byte aligned within the page- //
+	// aligned mapping, so they can be read where they lie.         //
+	const TraceRecord *records = (const TraceRecord *)(mapped.Data() + sizeof(header));
+	size_t nbrRecords = (mapped.Size() - sizeof(header)) / sizeof(TraceRecord);
+	for (size_t r = 0; r < nbrRecords; r++)
+	{
+		const TraceRecord &record = records[r];
+		if (!Matches(record, filter))
+			continue;
+
+		if (summary.records == 0 || record.tick < summary.firstTick)
+			summary.firstTick = record.tick;
+		if (summary.records == 0 || record.tick > summary.lastTick)
+			summary.lastTick = record.tick;
+		summary.records++;
+		if (record.type < NBR_TRACE_EVENT_TYPES)
+			summary.typeCount[record.type]++;
+		if (record.type == TRACE_STAGE_CHANGE && record.value < MAX_STAGES)
+		{
+			summary.stageCount[record.value]++;
+			if (record.value > summary.lastStage)
+				summary.lastStage = record.value;
+		}
+		if (record.type == TRACE_COLLISION)
+		{
+			CountCollision(summary, record.starA);
+			CountCollision(summary, record.starB);
+		}
+
+		if (list)
+		{
+			printf("%10llu  %-9s  %8d", (unsigned long long)record.tick, TraceEventName(record.type), record.starA);
+			if (record.starB >= 0)
+				printf("  %8d", record.starB);
+			if (record.type == TRACE_FREEZE || record.type == TRACE_STAGE_CHANGE)
+				printf("  value %u", record.value);
+			printf("\n");
+		}
+	}
+	printf("%s: file %u, %lu records\n", fileName, header.fileIndex, (unsigned long)nbrRecords);
+	return true;
+}
+
+static bool MoreCollisions(const pair<unsigned long, int> &a, const pair<unsigned long, int> &b)
+{
+	return a.first != b.first ? a.first > b.first : a.second < b.second;
+}
+
+int main(int argc, char **argv)
+{
+	TraceFilter filter;
+	filter.type = 0;
+	filter.star = -1;
+	filter.fromTick = 0;
+	filter.toTick = UINT64_MAX;
+	int  nbrTop = DEFAULT_TOP_STARS;
+	bool list = false;
+	vector<const char *> fileNames;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--type") == 0 && i + 1 < argc)
+		{
+			filter.type = ParseEventType(argv[++i]);
+			if (filter.type == 0)
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--star") == 0 && i + 1 < argc)
+			filter.star = atol(argv[++i]);
+		else if (strcmp(argv[i], "--from") == 0 && i + 1 < argc)
+			filter.fromTick = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--to") == 0 && i + 1 < argc)
+			filter.toTick = strtoull(argv[++i], NULL, 10);
+		else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc)
+			nbrTop = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--list") == 0)
+			list = true;
+		else if (argv[i][0] == '-')
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+		else
+			fileNames.push_back(argv[i]);
+	}
+	if (fileNames.empty() || nbrTop < 0)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	TraceSummary summary;
+	summary.records = 0;
+	summary.firstTick = 0;
+	summary.lastTick = 0;
+	memset(summary.typeCount, 0, sizeof(summary.typeCount));
+	memset(summary.stageCount, 0, sizeof(summary.stageCount));
+	summary.lastStage = 0;
+
+	bool valid = true;
+	for (size_t f = 0; f < fileNames.size(); f++)
+		if (!SummarizeFile(fileNames[f], filter, list, summary))
+			valid = false;
+
+	printf("matching records: %lu\n", summary.records);
+	if (summary.records > 0)
+		printf("ticks:            %llu .. %llu\n", (unsigned long long)summary.firstTick, (unsigned long long)summary.lastTick);
+	for (int t = TRACE_COLLISION; t < NBR_TRACE_EVENT_TYPES; t++)
+		printf("%-9s         %lu\n", TraceEventName(t), summary.typeCount[t]);
+	for (int s = 1; s <= summary.lastStage; s++)
+		printf("  stage %d:        %lu\n", s, summary.stageCount[s]);
+
+	vector<pair<unsigned long, int> > busiest;
+	for (size_t star = 0; star < summary.starCollisions.size(); star++)
+		if (summary.starCollisions[star] > 0)
+			busiest.push_back(make_pair(summary.starCollisions[star], (int)star));
+	size_t nbrListed = min(busiest.size(), (size_t)nbrTop);
+	partial_sort(busiest.begin(), busiest.begin() + nbrListed, busiest.end(), MoreCollisions);
+	if (nbrListed > 0)
+		printf("most collisions:\n");
+	for (size_t k = 0; k < nbrListed; k++)
+		printf("  star %8d:   %lu\n", busiest[k].second, busiest[k].first);
+
+	return valid ? 0 : 1;
+}
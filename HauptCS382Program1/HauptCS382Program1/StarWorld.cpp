@@ -0,0 +1,1004 @@
+/***********************************************************************/
+/* Filename: StarWorld.cpp                                             */
+/* Star motion, window reflection, collision detection and collision  */
+/* effects, lifted out of the GLUT callbacks so they can be stepped   */
+/* from any front end.                                                 */
+/***********************************************************************/
+
+#include "StarWorld.h"
+#include <algorithm>
+#include <cmath>			// Header File For Math Library
+#include <cstring>			// Header File For strcmp()
+using namespace std;
+
+
+/* Name of the parameterized broad phase, as accepted by ParseBroadPhase. */
+const char *BroadPhaseName(BroadPhase broadPhase)
+{
+	switch (broadPhase)
+	{
+	case BROAD_PHASE_BRUTE_FORCE: return "brute";
+	case BROAD_PHASE_GRID:        return "grid";
+	case BROAD_PHASE_SWEEP:       return "sweep";
+	}
+	return "unknown";
+}
+
+/* Look up a broad phase by name; returns false if the name is unknown. */
+bool ParseBroadPhase(const char *name, BroadPhase &broadPhase)
+{
+	for (int b = BROAD_PHASE_BRUTE_FORCE; b <= BROAD_PHASE_SWEEP; b++)
+	{
+		if (strcmp(name, BroadPhaseName((BroadPhase)b)) == 0)
+		{
+			broadPhase = (BroadPhase)b;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/* Name of the parameterized collision mode, as accepted by ParseCollisionMode. */
+const char *CollisionModeName(CollisionMode collisionMode)
+{
+	switch (collisionMode)
+	{
+	case COLLISION_DISCRETE:   return "discrete";
+	case COLLISION_CONTINUOUS: return "continuous";
+	}
+	return "unknown";
+}
+
+/* Look up a collision mode by name; returns false if the name is unknown. */
+bool ParseCollisionMode(const char *name, CollisionMode &collisionMode)
+{
+	for (int m = COLLISION_DISCRETE; m <= COLLISION_CONTINUOUS; m++)
+	{
+		if (strcmp(name, CollisionModeName((CollisionMode)m)) == 0)
+		{
+			collisionMode = (CollisionMode)m;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+/* Set up a fresh default-sized game using the default window extents. */
+StarWorld::StarWorld()
+{
+	windowWidth = 4.0f;
+	windowHeight = 3.0f;
+	events = NULL;
+	pool = NULL;
+	profiler = NULL;
+	seed = DEFAULT_SEED;
+	broadPhase = BROAD_PHASE_GRID;
+	collisionMode = COLLISION_DISCRETE;
+	kinematics = BestKinematicsPath();
+	tickSeconds = 1.0f / DEFAULT_SIM_HZ;
+	Reset(NBR_STARS, 0.0);
+}
+
+/* Re-initialize the parameterized number of stars and every counter; */
+/* the game clock starts at the parameterized time.                   */
+void StarWorld::Reset(int starCount, double currentSeconds)
+{
+	Allocate(starCount);
+
+	// Stars start inside the largest centered square that fits the window. //
+	float spawnExtent = (windowWidth < windowHeight ? windowWidth : windowHeight) / 2.0f;
+
+	SpawnContext spawn;
+	spawn.world = this;
+	spawn.spawnExtent = spawnExtent;
+	if (pool != NULL)
+		pool->ParallelFor(nbrStars, TICK_CHUNK_STARS, SpawnChunk, &spawn);
+	else
+		SpawnChunk(&spawn, 0, nbrStars);
+
+	TOTAL_COLLISIONS = 0;
+	YELLOW_STARS = 0;
+	CallInc = 0;
+	gameOver = false;
+	startTime = currentSeconds;
+	GAME_SECONDS = 0;
+	tickCount = 0;
+	freezeTimers.Reset(nbrStars, tickCount);
+	broadPhaseStale = true;
+	broadPhaseTick = 0;
+	sweep.Invalidate();
+}
+
+/* Size every per-star array for the parameterized number of stars; */
+/* their contents are left for the caller to fill in.                */
+void StarWorld::Allocate(int starCount)
+{
+	nbrStars = starCount;
+	x.resize(nbrStars);
+	y.resize(nbrStars);
+	prevX.resize(nbrStars);
+	prevY.resize(nbrStars);
+	xInc.resize(nbrStars);
+	yInc.resize(nbrStars);
+	spin.resize(nbrStars);
+	spinInc.resize(nbrStars);
+	spinCos.resize(nbrStars);
+	spinSin.resize(nbrStars);
+	pulsation.resize(nbrStars);
+	pulsationInc.resize(nbrStars);
+	radius.resize(nbrStars);
+	freezeLimit.resize(nbrStars);
+	freezeDeadline.resize(nbrStars);
+	collisionCnt.resize(nbrStars);
+	stage.resize(nbrStars);
+	basePulsationInc.resize(nbrStars);
+	baseSpinInc.resize(nbrStars);
+	color.resize(3 * nbrStars);
+}
+
+/* Bring the derived bookkeeping up to date after the per-star arrays */
+/* have been filled in from outside (a restored snapshot, say).       */
+void StarWorld::StateChanged()
+{
+	freezeTimers.Reset(nbrStars, tickCount);
+	for (int i = 0; i < nbrStars; i++)
+		if (freezeLimit[i] > 0)
+			freezeTimers.Schedule(i, freezeDeadline[i]);
+	broadPhaseStale = true;
+	sweep.Invalidate();
+}
+
+/* Give the indexed star a fresh random position, velocity, spin rate */
+/* and pulsation rate, all drawn from the star's own stream of the    */
+/* world's seed, and put it back in its initial state.                */
+void StarWorld::SpawnStar(int index, float spawnExtent)
+{
+	StarRandom random(seed, index);
+	radius[index] = STAR_RADIUS * stages.radiusFactor[0];
+
+	// Randomly generated initial position (inside window). //
+	x[index] = random.Uniform(-spawnExtent + radius[index], spawnExtent - radius[index]);
+	y[index] = random.Uniform(-spawnExtent + radius[index], spawnExtent - radius[index]);
+
+	// Randomly generated velocity. The rates below are per tick //
+	// at the default tick rate, converted to per second.         //
+	float speed = random.Uniform(0.010f, 0.045f) * DEFAULT_SIM_HZ; // random speed
+	xInc[index] = random.Uniform(speed / 4.0f, speed);
+	yInc[index] = sqrt(speed * speed - xInc[index] * xInc[index]);
+	float randNbr = random.Uniform(-1.0, 1.0);
+	if (randNbr < 0.0f)
+		xInc[index] *= -1.0f;
+	randNbr = random.Uniform(-1.0, 1.0);
+	if (randNbr < 0.0f)
+		yInc[index] *= -1.0f;
+
+	// Initial orientation: zero. //
+	spin[index] = 0.0f;
+	spinCos[index] = 1.0f;
+	spinSin[index] = 0.0f;
+	baseSpinInc[index] = random.Uniform(0.15f, 0.55f) * DEFAULT_SIM_HZ;
+	spinInc[index] = baseSpinInc[index] * stages.spinFactor[0];
+
+	pulsation[index] = 1.0f;
+	basePulsationInc[index] = random.Uniform(0.065f, 0.095f) * DEFAULT_SIM_HZ; // unique pulsation rate for each star
+	pulsationInc[index] = basePulsationInc[index] * stages.pulsationFactor[0];
+
+	// Star initialized in unfrozen state. //
+	freezeLimit[index] = 0;
+	freezeDeadline[index] = 0;
+
+	// Initialize collision count and stage (cyan, by default). //
+	collisionCnt[index] = 0;
+	stage[index] = 0;
+	color[3 * index + 0] = stages.red[0];
+	color[3 * index + 1] = stages.green[0];
+	color[3 * index + 2] = stages.blue[0];
+
+	prevX[index] = x[index];
+	prevY[index] = y[index];
+}
+
+/* Spawn one chunk of the stars (a SpawnContext). */
+void StarWorld::SpawnChunk(void *context, int first, int last)
+{
+	SpawnContext *spawn = (SpawnContext *)context;
+	for (int i = first; i < last; i++)
+		spawn->world->SpawnStar(i, spawn->spawnExtent);
+}
+
+/* Recompute the world extents for a window of the parameterized size, */
+/* matching the orthographic projection set up by the display code.    */
+void StarWorld::SetViewport(int w, int h)
+{
+	if (w <= h)
+	{
+		windowWidth = 2.0f;
+		windowHeight = 2.0f * (float)h / (float)w;
+	}
+	else
+	{
+		windowWidth = 2.0f * (float)w / (float)h;
+		windowHeight = 2.0f;
+	}
+}
+
+/* Announce an event of the current tick on the front end's bus, if */
+/* it supplied one. This never waits on what the consumers do.       */
+void StarWorld::Publish(StarEventType type, int starA, int starB, int valueA, int valueB)
+{
+	if (events == NULL)
+		return;
+	StarEvent event;
+	event.tick = tickCount;
+	event.type = type;
+	event.starA = starA;
+	event.starB = starB;
+	event.valueA = valueA;
+	event.valueB = valueB;
+	event.count = TOTAL_COLLISIONS;
+	events->Publish(event);
+}
+
+/* One chunk of the tick's star updates. Chunks share no stars, and */
+/* each star's update depends only on that star, so the chunks may   */
+/* run on any threads in any order with the same result.             */
+struct TickChunk
+{
+	StarWorld *world;
+	KinematicsStep step;
+};
+
+static void RunTickChunk(void *context, int first, int last)
+{
+	TickChunk *chunk = (TickChunk *)context;
+	StarWorld &world = *chunk->world;
+	memcpy(&world.prevX[first], &world.x[first], (last - first) * sizeof(float));
+	memcpy(&world.prevY[first], &world.y[first], (last - first) * sizeof(float));
+	RunKinematics(world.kinematics, chunk->step, first, last);
+}
+
+/* Advance every star by one tick of tickSeconds: pulsation, motion */
+/* and reflection off of the window borders in the kinematics kernel */
+/* (spread over the thread pool, if there is one), then the expiry   */
+/* of any freezes.                                                   */
+void StarWorld::Tick()
+{
+	tickCount++;
+
+	if (nbrStars > 0)
+	{
+		ProfileScope scope(profiler, PHASE_MOTION);
+		TickChunk chunk;
+		chunk.world = this;
+		KinematicsStep &step = chunk.step;
+		step.x = &x[0];
+		step.y = &y[0];
+		step.xInc = &xInc[0];
+		step.yInc = &yInc[0];
+		step.spin = &spin[0];
+		step.spinInc = &spinInc[0];
+		step.spinCos = &spinCos[0];
+		step.spinSin = &spinSin[0];
+		step.pulsation = &pulsation[0];
+		step.pulsationInc = &pulsationInc[0];
+		step.radius = &radius[0];
+		step.freezeLimit = &freezeLimit[0];
+		step.tickSeconds = tickSeconds;
+		step.halfWidth = windowWidth / 2.0f;
+		step.halfHeight = windowHeight / 2.0f;
+		if (pool != NULL)
+			pool->ParallelFor(nbrStars, TICK_CHUNK_STARS, RunTickChunk, &chunk);
+		else
+			RunTickChunk(&chunk, 0, nbrStars);
+	}
+
+	// Frozen stars stayed put this tick; release those whose freeze //
+	// ends on it, in star order so the trace reads the same however //
+	// the wheel filed them.                                         //
+	ProfileScope scope(profiler, PHASE_THAW);
+	thawed.clear();
+	freezeTimers.Advance(tickCount, thawed);
+	sort(thawed.begin(), thawed.end());
+	for (size_t k = 0; k < thawed.size(); k++)
+	{
+		int i = thawed[k];
+		freezeLimit[i] = 0;
+		Publish(EVENT_UNFREEZE, i);
+	}
+}
+
+/* Run collision detection for every star, then update the game timer */
+/* and nudge stragglers along if the game has stalled.                */
+void StarWorld::ResolveCollisions(double currentSeconds)
+{
+	ResolveContacts();
+
+	// Update TIMER
+	if (gameOver == false) {
+		GAME_SECONDS = (int)(currentSeconds - startTime);
+	}
+
+	HelpGameAlong();
+
+	// The frame is over: its beeps are played together, merged. //
+	Publish(EVENT_STEP_END, -1);
+}
+
+/* One complete simulation step, in the same order the GLUT front end */
+/* performs it: the timer tick followed by the display-time collisions. */
+void StarWorld::Step(double currentSeconds)
+{
+	Tick();
+	ResolveCollisions(currentSeconds);
+}
+
+/* Rebuild the selected broad phase from the current star positions.  */
+/* The grid's cells are as wide as the largest collision reach in     */
+/* play, enlarged by the parameterized headroom factor.               */
+void StarWorld::BuildBroadPhase(float headroom)
+{
+	ProfileScope scope(profiler, PHASE_BROAD_PHASE);
+	float maxReach = 0.0f;
+	reach.resize(nbrStars);
+	for (int i = 0; i < nbrStars; i++)
+	{
+		reach[i] = CollisionReach(i);
+		if (reach[i] > maxReach)
+			maxReach = reach[i];
+	}
+	IndexReach(maxReach, headroom);
+	broadPhaseStale = false;
+	broadPhaseTick = tickCount;
+}
+
+/* Build the selected broad phase over the current star positions and */
+/* the reaches in the reach array, the largest of which is given.     */
+void StarWorld::IndexReach(float maxReach, float headroom)
+{
+	if (maxReach <= 0.0f)
+		maxReach = 0.9f * STAR_RADIUS;
+
+	if (broadPhase == BROAD_PHASE_GRID)
+		grid.Build(&x[0], &y[0], &reach[0], nbrStars, windowWidth, windowHeight, maxReach * headroom);
+	else if (broadPhase == BROAD_PHASE_SWEEP)
+		sweep.Build(&x[0], &y[0], &reach[0], nbrStars);
+}
+
+/* Keep the broad phase's copy of the indexed star's collision reach */
+/* current after the star grows, and have the grid rebuilt if the     */
+/* star has outgrown its cells.                                       */
+void StarWorld::UpdateReach(int index)
+{
+	if (broadPhaseStale)
+		return;
+	float starReach = CollisionReach(index);
+	if (broadPhase == BROAD_PHASE_GRID)
+	{
+		grid.slotReach[grid.starSlot[index]] = starReach;
+		if (starReach > grid.cellSize)
+			broadPhaseStale = true;
+	}
+	else if (broadPhase == BROAD_PHASE_SWEEP)
+	{
+		sweep.slotReach[sweep.starSlot[index]] = starReach;
+		if (starReach > sweep.maxReach)
+			sweep.maxReach = starReach;
+	}
+}
+
+/* Answer a collision between the two indexed stars, once for the */
+/* pair: each takes the other's trajectory, both count the hit (up */
+/* to the collision limit), and the hit is counted once overall.   */
+/* Both stars are queued in collided; their stages are brought up  */
+/* to date for the whole pass together, by StageCollided.          */
+void StarWorld::RespondToCollision(int starA, int starB)
+{
+	// Trade trajectories: the same response seen from either star. //
+	float swapX = xInc[starA];
+	float swapY = yInc[starA];
+	xInc[starA] = xInc[starB];
+	yInc[starA] = yInc[starB];
+	xInc[starB] = swapX;
+	yInc[starB] = swapY;
+
+	// A stage file may hold more stages than the game's collision limit. //
+	int limit = stages.NbrStages() > COLLISION_LIMIT ? stages.NbrStages() : COLLISION_LIMIT;
+	int stars[2] = { starA, starB };
+	for (int s = 0; s < 2; s++)
+		if (collisionCnt[stars[s]] < limit) // make sure collision limit is not exceeded
+			collisionCnt[stars[s]] = collisionCnt[stars[s]] + 1;
+
+	TOTAL_COLLISIONS = TOTAL_COLLISIONS + 1;
+	Publish(EVENT_COLLISION, starA, starB, collisionCnt[starA], collisionCnt[starB]);
+
+	collided.push_back(starA);
+	collided.push_back(starB);
+}
+
+/* Whether the indexed stars are closing in on each other: their     */
+/* velocities carry them toward each other along the line between    */
+/* the parameterized separation (starA's center less starB's). Stars */
+/* that have already answered a contact are moving apart, so a pair  */
+/* that stays overlapping is not answered again.                     */
+bool StarWorld::Approaching(int starA, int starB, float separationX, float separationY) const
+{
+	return separationX * (xInc[starA] - xInc[starB]) + separationY * (yInc[starA] - yInc[starB]) < 0.0f;
+}
+
+/* Find the first moment during the latest tick at which the indexed */
+/* stars touched, as a fraction of the tick: each center moves in a  */
+/* straight line from where it was before the tick to where it is    */
+/* now, and they touch when one center comes within the larger of    */
+/* their collision reaches of the other (reaches as they are now).   */
+/* Returns false if they never touched, or if they were touching as  */
+/* the tick began but not closing in.                                */
+bool StarWorld::ContactTime(int starA, int starB, float &time) const
+{
+	float startX = prevX[starA] - prevX[starB];
+	float startY = prevY[starA] - prevY[starB];
+	float moveX = (x[starA] - x[starB]) - startX;
+	float moveY = (y[starA] - y[starB]) - startY;
+	float contactReach = reach[starA] > reach[starB] ? reach[starA] : reach[starB];
+
+	// |start + t * move|^2 = contactReach^2, solved for the earlier root. //
+	float c = startX * startX + startY * startY - contactReach * contactReach;
+	if (c < 0.0f)
+	{
+		time = 0.0f;                  // Touching as the tick began. //
+		return Approaching(starA, starB, startX, startY);
+	}
+	float a = moveX * moveX + moveY * moveY;
+	float halfB = startX * moveX + startY * moveY;
+	if (a <= 0.0f || halfB >= 0.0f)
+		return false;                 // Not closing in. //
+	float discriminant = halfB * halfB - a * c;
+	if (discriminant < 0.0f)
+		return false;                 // The paths pass wide of each other. //
+	time = (-halfB - sqrt(discriminant)) / a;
+	return time <= 1.0f;
+}
+
+/* Whether the indexed stars collided during the latest tick, and when */
+/* (as a fraction of the tick). In discrete mode they collide if, at    */
+/* the end of the tick, one center lies within the larger of their      */
+/* collision reaches of the other and they are closing in; rather than  */
+/* determining whether the stars' outlines precisely overlap, this      */
+/* merely checks 90% of the distance between a center and any of its    */
+/* tip vertices.                                                        */
+bool StarWorld::Touching(int starA, int starB, float &time) const
+{
+	if (collisionMode == COLLISION_CONTINUOUS)
+		return ContactTime(starA, starB, time);
+	float dx = x[starA] - x[starB];
+	float dy = y[starA] - y[starB];
+	float contactReach = reach[starA] > reach[starB] ? reach[starA] : reach[starB];
+	time = 1.0f;
+	return dx * dx + dy * dy < contactReach * contactReach && Approaching(starA, starB, dx, dy);
+}
+
+/* Rebuild the broad phase for a collision pass. For continuous mode */
+/* it is built with each reach stretched by how far its star and the */
+/* fastest star moved, so it offers every pair that could have met   */
+/* anywhere on the way.                                              */
+void StarWorld::BuildContactPhase()
+{
+	if (collisionMode == COLLISION_DISCRETE)
+	{
+		BuildBroadPhase(1.0f);
+		return;
+	}
+
+	ProfileScope scope(profiler, PHASE_BROAD_PHASE);
+	float maxTravel = 0.0f;
+	float maxReach = 0.0f;
+	reach.resize(nbrStars);
+	for (int i = 0; i < nbrStars; i++)
+	{
+		float dx = x[i] - prevX[i];
+		float dy = y[i] - prevY[i];
+		float travel = sqrt(dx * dx + dy * dy);
+		if (travel > maxTravel)
+			maxTravel = travel;
+	}
+	for (int i = 0; i < nbrStars; i++)
+	{
+		float dx = x[i] - prevX[i];
+		float dy = y[i] - prevY[i];
+		reach[i] = CollisionReach(i) + sqrt(dx * dx + dy * dy) + maxTravel;
+		if (reach[i] > maxReach)
+			maxReach = reach[i];
+	}
+	IndexReach(maxReach, 1.0f);
+
+	// The broad phase now holds swept reaches; anything else that //
+	// uses it must rebuild it first.                              //
+	broadPhaseStale = true;
+	for (int i = 0; i < nbrStars; i++)
+		reach[i] = CollisionReach(i);
+}
+
+/* Hand every pair of stars that collided during the latest tick to the */
+/* parameterized visitor, as (lower index, higher index, time), each    */
+/* pair once. The broad phase offers the candidates, visited in its own */
+/* order (cell by cell, or along x) so consecutive stars touch          */
+/* neighboring memory; it must have been built by BuildContactPhase.    */
+template <class Visit>
+void StarWorld::ForEachContact(Visit visit)
+{
+	float time;
+	if (broadPhase == BROAD_PHASE_GRID)
+	{
+		for (int k = 0; k < nbrStars; k++)
+		{
+			// Each pair is taken from its lower-indexed star only. //
+			int i = grid.cellStars[k];
+			int column = grid.starCell[i] % grid.columns;
+			int row = grid.starCell[i] / grid.columns;
+			int firstRow = row > 0 ? row - 1 : 0;
+			int lastRow = row < grid.rows - 1 ? row + 1 : row;
+			int firstColumn = column > 0 ? column - 1 : 0;
+			int lastColumn = column < grid.columns - 1 ? column + 1 : column;
+			for (int r = firstRow; r <= lastRow; r++)
+			{
+				int first = grid.cellStart[r * grid.columns + firstColumn];
+				int last = grid.cellStart[r * grid.columns + lastColumn + 1];
+				for (int slot = first; slot < last; slot++)
+				{
+					int j = grid.cellStars[slot];
+					if (j > i && Touching(i, j, time))
+						visit(i, j, time);
+				}
+			}
+		}
+	}
+	else if (broadPhase == BROAD_PHASE_SWEEP)
+	{
+		// Each pair is taken from its leftmost star only, scanning //
+		// right while the next star is within the largest reach.   //
+		for (int k = 0; k < nbrStars; k++)
+		{
+			int star = sweep.slotStar[k];
+			float starX = sweep.slotX[k];
+			for (int slot = k + 1; slot < nbrStars && sweep.slotX[slot] - starX < sweep.maxReach; slot++)
+			{
+				int other = sweep.slotStar[slot];
+				int i = star < other ? star : other;
+				int j = star < other ? other : star;
+				if (Touching(i, j, time))
+					visit(i, j, time);
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < nbrStars; i++)
+			for (int j = i + 1; j < nbrStars; j++)
+				if (Touching(i, j, time))
+					visit(i, j, time);
+	}
+}
+
+/* The lowest-indexed star above the indexed one that collided with it  */
+/* during the latest tick and has no contact to answer yet, or -1. The  */
+/* broad phase offers the candidates; a grid cell lists its stars in    */
+/* increasing index, so each cell is searched only up to the lowest     */
+/* partner found so far. The sweep has no such order, so it first asks  */
+/* lowestAbove (see SweepLowestAbove): only a star whose lowest partner */
+/* of all has been taken is searched for another.                       */
+int StarWorld::LowestPartner(int star)
+{
+	float time;
+	int lowest = nbrStars;
+	if (broadPhase == BROAD_PHASE_GRID)
+	{
+		int column = grid.starCell[star] % grid.columns;
+		int row = grid.starCell[star] / grid.columns;
+		int firstRow = row > 0 ? row - 1 : 0;
+		int lastRow = row < grid.rows - 1 ? row + 1 : row;
+		int firstColumn = column > 0 ? column - 1 : 0;
+		int lastColumn = column < grid.columns - 1 ? column + 1 : column;
+		for (int r = firstRow; r <= lastRow; r++)
+			for (int c = firstColumn; c <= lastColumn; c++)
+			{
+				int cell = r * grid.columns + c;
+				for (int slot = grid.cellStart[cell]; slot < grid.cellStart[cell + 1]; slot++)
+				{
+					int other = grid.cellStars[slot];
+					if (other >= lowest)
+						break;
+					if (other > star && !responded[other] && Touching(star, other, time))
+					{
+						lowest = other;
+						break;
+					}
+				}
+			}
+	}
+	else if (broadPhase == BROAD_PHASE_SWEEP)
+	{
+		if (lowestAbove[star] < 0 || !responded[lowestAbove[star]])
+			return lowestAbove[star];
+
+		// Scan both ways along x while the next star is within the //
+		// largest reach.                                           //
+		int k = sweep.starSlot[star];
+		float starX = sweep.slotX[k];
+		for (int slot = k + 1; slot < nbrStars && sweep.slotX[slot] - starX < sweep.maxReach; slot++)
+		{
+			int other = sweep.slotStar[slot];
+			if (other > star && other < lowest && !responded[other] && Touching(star, other, time))
+				lowest = other;
+		}
+		for (int slot = k - 1; slot >= 0 && starX - sweep.slotX[slot] < sweep.maxReach; slot--)
+		{
+			int other = sweep.slotStar[slot];
+			if (other > star && other < lowest && !responded[other] && Touching(star, other, time))
+				lowest = other;
+		}
+	}
+	else
+	{
+		for (int other = star + 1; other < nbrStars && lowest == nbrStars; other++)
+			if (!responded[other] && Touching(star, other, time))
+				lowest = other;
+	}
+	return lowest < nbrStars ? lowest : -1;
+}
+
+/* Fill in lowestAbove for the sweep: each star's lowest-indexed      */
+/* partner above it, taken or not, or -1. One pass in slot order,     */
+/* scanning right as ForEachContact does, tests only the pairs that   */
+/* would lower a star's partner.                                      */
+void StarWorld::SweepLowestAbove()
+{
+	float time;
+	lowestAbove.assign(nbrStars, -1);
+	for (int k = 0; k < nbrStars; k++)
+	{
+		int star = sweep.slotStar[k];
+		float starX = sweep.slotX[k];
+		for (int slot = k + 1; slot < nbrStars && sweep.slotX[slot] - starX < sweep.maxReach; slot++)
+		{
+			int other = sweep.slotStar[slot];
+			int i = star < other ? star : other;
+			int j = star < other ? other : star;
+			if ((lowestAbove[i] < 0 || j < lowestAbove[i]) && Touching(i, j, time))
+				lowestAbove[i] = j;
+		}
+	}
+}
+
+/* The pairs of stars the next collision pass answers, in answering    */
+/* order, found exactly as it finds them but not answered. Each star   */
+/* answers at most one contact, and the pairs are the same whichever   */
+/* broad phase finds them. In discrete mode the pairs are taken in     */
+/* order of their indices: each star in turn, if still free, answers   */
+/* its lowest-indexed free partner. In continuous mode a star answers  */
+/* only its earliest contact, since its later ones were predicted on   */
+/* the path it is about to leave; a pair is answered when it is each   */
+/* star's earliest, in order of first touch (then by star index). Any  */
+/* contact left out is still there to be found on the next tick.       */
+const vector<StarContact> &StarWorld::FindContacts()
+{
+	BuildContactPhase();
+
+	ProfileScope scope(profiler, PHASE_COLLISION_DETECTION);
+	contacts.clear();
+	if (collisionMode == COLLISION_DISCRETE)
+	{
+		if (broadPhase == BROAD_PHASE_SWEEP)
+			SweepLowestAbove();
+		responded.assign(nbrStars, 0);
+		for (int i = 0; i < nbrStars; i++)
+		{
+			if (responded[i])
+				continue;
+			int partner = LowestPartner(i);
+			if (partner < 0)
+				continue;
+			responded[i] = 1;
+			responded[partner] = 1;
+			StarContact contact;
+			contact.time = 1.0f;
+			contact.starA = i;
+			contact.starB = partner;
+			contacts.push_back(contact);
+		}
+		return contacts;
+	}
+
+	StarContact none;
+	none.time = 2.0f;
+	none.starA = -1;
+	none.starB = -1;
+	firstContact.assign(nbrStars, none);
+	ForEachContact([this](int starA, int starB, float time)
+	{
+		StarContact contact;
+		contact.time = time;
+		contact.starA = starA;
+		contact.starB = starB;
+		if (contact < firstContact[starA])
+			firstContact[starA] = contact;
+		if (contact < firstContact[starB])
+			firstContact[starB] = contact;
+	});
+	for (int i = 0; i < nbrStars; i++)
+	{
+		const StarContact &contact = firstContact[i];
+		if (contact.starA == i && firstContact[contact.starB].starA == i)
+			contacts.push_back(contact);
+	}
+	sort(contacts.begin(), contacts.end());
+	return contacts;
+}
+
+/* Collision pass: answer the latest tick's collisions as FindContacts */
+/* lists them. In continuous mode both stars are also put back where   */
+/* they touched and sent on along their new trajectories for the rest  */
+/* of the tick.                                                        */
+void StarWorld::ResolveContacts()
+{
+	FindContacts();
+
+	ProfileScope scope(profiler, PHASE_COLLISION_DETECTION);
+	collided.clear();
+	for (size_t c = 0; c < contacts.size(); c++)
+	{
+		const StarContact &contact = contacts[c];
+		int starA = contact.starA;
+		int starB = contact.starB;
+		if (collisionMode == COLLISION_DISCRETE)
+		{
+			RespondToCollision(starA, starB);
+			continue;
+		}
+
+		float t = contact.time;
+		float touchX[2], touchY[2];
+		int stars[2] = { starA, starB };
+		for (int s = 0; s < 2; s++)
+		{
+			touchX[s] = prevX[stars[s]] + t * (x[stars[s]] - prevX[stars[s]]);
+			touchY[s] = prevY[stars[s]] + t * (y[stars[s]] - prevY[stars[s]]);
+		}
+
+		RespondToCollision(starA, starB);
+
+		// Frozen stars stay put, whatever their new trajectory. //
+		float remaining = (1.0f - t) * tickSeconds;
+		for (int s = 0; s < 2; s++)
+		{
+			if (freezeLimit[stars[s]] > 0)
+				continue;
+			x[stars[s]] = touchX[s] + xInc[stars[s]] * remaining;
+			y[stars[s]] = touchY[s] + yInc[stars[s]] * remaining;
+		}
+	}
+	StageCollided();
+}
+
+/* Bring the stages of the stars that collided this pass up to date   */
+/* with their collision counts, then give every one of them its       */
+/* stage's look in a single ApplyStages gather. A star whose stage    */
+/* did not change is given the look it already has, so none has to   */
+/* be picked out. Each star answers at most one contact a pass, so    */
+/* none is listed twice.                                              */
+void StarWorld::StageCollided()
+{
+	for (size_t k = 0; k < collided.size(); k++)
+		AdvanceStage(collided[k]);
+	ApplyStages(collided.data(), (int)collided.size());
+}
+
+/* Bring the indexed star's stage up to date with its collision count */
+/* and apply the change at once.                                       */
+void StarWorld::CollisionEffects(int index)
+{
+	if (AdvanceStage(index))
+		ApplyStages(&index, 1);
+}
+
+/* Move the indexed star to the stage its collision count has earned */
+/* (stages past the last one stay there) and keep the yellow count;  */
+/* returns true if the stage changed, after which the star still has */
+/* its old look until ApplyStages is called for it.                  */
+bool StarWorld::AdvanceStage(int index)
+{
+	int lastStage = stages.LastStage();
+	int newStage = collisionCnt[index] < lastStage ? collisionCnt[index] : lastStage;
+	if (newStage <= stage[index])
+		return false;
+	stage[index] = newStage;
+	Publish(EVENT_STAGE_CHANGE, index, -1, newStage);
+
+	if (newStage == lastStage) {
+		YELLOW_STARS = YELLOW_STARS + 1; // increment number of yellow stars
+
+		// end game if all stars are yellow
+		if (YELLOW_STARS == nbrStars && !gameOver) {
+			gameOver = true;
+			Publish(EVENT_GAME_OVER, index);
+		}
+	}
+	return true;
+}
+
+/* Give each of the parameterized stars the color, rates and radius of */
+/* its stage: one lookup per star in the stage table, whatever stages  */
+/* it passed through, with no branches on the stage. The pulsation     */
+/* keeps its current direction.                                        */
+void StarWorld::ApplyStages(const int *stars, int count)
+{
+	ProfileScope scope(profiler, PHASE_COLLISION_EFFECTS);
+	for (int k = 0; k < count; k++)
+	{
+		int i = stars[k];
+		int s = stage[i];
+		pulsationInc[i] = copysign(basePulsationInc[i] * stages.pulsationFactor[s], pulsationInc[i]);
+		spinInc[i] = baseSpinInc[i] * stages.spinFactor[s];
+		radius[i] = STAR_RADIUS * stages.radiusFactor[s];
+		color[3 * i + 0] = stages.red[s];
+		color[3 * i + 1] = stages.green[s];
+		color[3 * i + 2] = stages.blue[s];
+	}
+
+	// The broad phase holds its own copy of every star's reach. //
+	for (int k = 0; k < count; k++)
+		UpdateReach(stars[k]);
+}
+
+/* Return the index of the star whose center is nearest the current */
+/* mouse position among those containing it, or -1 if none does.     */
+int StarWorld::FindMouseHit(float mouseX, float mouseY)
+{
+	int hit;
+	FindMouseHits(&mouseX, &mouseY, 1, &hit);
+	return hit;
+}
+
+/* Hit-test each of the parameterized points as FindMouseHit does, */
+/* storing the results in the parameterized array. The broad phase */
+/* doubles as the spatial index; it is brought up to date once for */
+/* the whole batch, so each query only visits nearby stars.        */
+void StarWorld::FindMouseHits(const float *mouseX, const float *mouseY, int nbrPoints, int *hits)
+{
+	if (broadPhase != BROAD_PHASE_BRUTE_FORCE && (broadPhaseStale || broadPhaseTick != tickCount))
+		BuildBroadPhase(1.0f);
+	for (int p = 0; p < nbrPoints; p++)
+		hits[p] = NearestHit(mouseX[p], mouseY[p]);
+}
+
+/* Nearest star whose collision reach contains the parameterized point, */
+/* or -1. Rather than determining whether the point lies precisely      */
+/* within the star's boundaries, this merely checks whether it is       */
+/* within 90% of the distance between the star's center and any of its */
+/* pulsed tip vertices, the same test collisions use. Ties go to the    */
+/* lower star index. The broad phase must be current.                   */
+int StarWorld::NearestHit(float pointX, float pointY) const
+{
+	int nearest = -1;
+	float nearestDistance = 0.0f;
+
+	if (broadPhase == BROAD_PHASE_GRID)
+	{
+		// No reach exceeds the cell size, so only the point's cell //
+		// and the eight around it can hold a star containing it.   //
+		int column = grid.Column(pointX);
+		int row = grid.Row(pointY);
+		int firstRow = row > 0 ? row - 1 : 0;
+		int lastRow = row < grid.rows - 1 ? row + 1 : row;
+		int firstColumn = column > 0 ? column - 1 : 0;
+		int lastColumn = column < grid.columns - 1 ? column + 1 : column;
+
+		for (int r = firstRow; r <= lastRow; r++)
+		{
+			int first = grid.cellStart[r * grid.columns + firstColumn];
+			int last = grid.cellStart[r * grid.columns + lastColumn + 1];
+			for (int k = first; k < last; k++)
+			{
+				float dx = pointX - grid.slotX[k];
+				float dy = pointY - grid.slotY[k];
+				float distance = dx * dx + dy * dy;
+				if (distance < grid.slotReach[k] * grid.slotReach[k] &&
+					(nearest < 0 || distance < nearestDistance ||
+					(distance == nearestDistance && grid.cellStars[k] < nearest)))
+				{
+					nearest = grid.cellStars[k];
+					nearestDistance = distance;
+				}
+			}
+		}
+	}
+	else if (broadPhase == BROAD_PHASE_SWEEP)
+	{
+		// Only stars within the largest reach along x can contain the //
+		// point; binary search for the first of them.                 //
+		int first = (int)(lower_bound(sweep.slotX.begin(), sweep.slotX.end(), pointX - sweep.maxReach) - sweep.slotX.begin());
+		for (int k = first; k < nbrStars && sweep.slotX[k] - pointX < sweep.maxReach; k++)
+		{
+			float dx = pointX - sweep.slotX[k];
+			float dy = pointY - sweep.slotY[k];
+			float distance = dx * dx + dy * dy;
+			if (distance < sweep.slotReach[k] * sweep.slotReach[k] &&
+				(nearest < 0 || distance < nearestDistance ||
+				(distance == nearestDistance && sweep.slotStar[k] < nearest)))
+			{
+				nearest = sweep.slotStar[k];
+				nearestDistance = distance;
+			}
+		}
+	}
+	else
+	{
+		for (int i = 0; i < nbrStars; i++)
+		{
+			float dx = pointX - x[i];
+			float dy = pointY - y[i];
+			float distance = dx * dx + dy * dy;
+			float starReach = CollisionReach(i);
+			if (distance < starReach * starReach && (nearest < 0 || distance < nearestDistance))
+			{
+				nearest = i;
+				nearestDistance = distance;
+			}
+		}
+	}
+	return nearest;
+}
+
+/* Release the indexed star if it is frozen, or freeze it if it is moving. */
+/* A star whose collisions have used up the freeze interval, however       */
+/* many stages the table has, cannot be frozen: the click is refused       */
+/* without a freeze event (or its beep).                                   */
+void StarWorld::ToggleFreeze(int index)
+{
+	if (freezeLimit[index] > 0)
+	{
+		freezeLimit[index] = 0;
+		freezeTimers.Cancel(index);
+		Publish(EVENT_UNFREEZE, index);
+	}
+	else
+	{
+		freezeLimit[index] = (FREEZE_INTERVAL - collisionCnt[index]); //Freeze time = Initial freeze limit - collision count
+		if (freezeLimit[index] <= 0)
+		{
+			freezeLimit[index] = 0;
+			return;
+		}
+
+		// The star thaws on the tick that ends its limit, counted in //
+		// whole ticks so no clock is read and no time drifts.        //
+		freezeDeadline[index] = tickCount + (unsigned long)(freezeLimit[index] / tickSeconds + 0.5f);
+		freezeTimers.Schedule(index, freezeDeadline[index]);
+		Publish(EVENT_FREEZE, index, -1, freezeLimit[index]);
+	}
+}
+
+/* Help game along if we get stuck: after enough collisions (or enough */
+/* game time) every star is pushed to at least the next stage.  The    */
+/* collision totals are set for the default game and scale with the    */
+/* number of stars, so larger games are not over before they start.    */
+void StarWorld::HelpGameAlong()
+{
+	// Collision totals (for NBR_STARS stars) and game times at which each pass fires. //
+	static const uint64_t HELP_COLLISIONS[5] = { 250, 450, 650, 750, 850 };
+	static const int HELP_SECONDS[5] = { 79, 142, 215, 287, 358 };
+
+	while (CallInc < 5 && (TOTAL_COLLISIONS * NBR_STARS >= HELP_COLLISIONS[CallInc] * (uint64_t)nbrStars || GAME_SECONDS == HELP_SECONDS[CallInc])) {
+		int pass = CallInc + 1;
+		staged.clear();
+		for (int i = 0; i < nbrStars; i++) {
+			if (collisionCnt[i] < pass) {
+				collisionCnt[i] = pass;
+				if (AdvanceStage(i))
+					staged.push_back(i);
+			}
+		}
+		ApplyStages(staged.data(), (int)staged.size());
+		CallInc = CallInc + 1;
+	}
+}
@@ -0,0 +1,229 @@
+/***********************************************************************/
+/* Filename: StarWorld.h                                               */
+/* Window-independent simulation core for the pulsating stars game.    */
+/* Holds the star population and the game counters, and advances them */
+/* one tick at a time without needing a GL context or a GLUT event    */
+/* loop.                                                               */
+/***********************************************************************/
+
+#ifndef STAR_WORLD_H
+#define STAR_WORLD_H
+
+#include <vector>
+#include "StarEvents.h"
+#include "StarGrid.h"
+#include "StarKinematics.h"
+#include "StarShape.h"
+#include "StarProfiler.h"
+#include "StarRandom.h"
+#include "StarStages.h"
+#include "StarSweep.h"
+#include "StarThreadPool.h"
+#include "StarTimerWheel.h"
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const float PI_OVER_180 = 0.0174532925f;         // One degree (in radians).         //
+
+const int   FREEZE_BEEP_DURATION = 25;                    // # msec per beep for freezing.    //
+const int   FREEZE_BEEP_FREQUENCY = 1000;                  // Freezing beep audio frequency.   //
+const int   UNFREEZE_BEEP_DURATION = 25;                    // # msec per beep for unfreezing.  //
+const int   UNFREEZE_BEEP_FREQUENCY = 400;                   // Unfreezing beep audio frequency. //
+
+const int   COLLISION_BEEP_DURATION = 25;                    // # msec per beep for collision.  //
+const int   COLLISION_BEEP_FREQUENCY = 400;                   // collision beep audio frequency. //
+
+const int   NBR_STARS = 12;                    // Default # stars in game.         //
+const int   MAX_STARS = 1 << 24;               // Largest supported star count.    //
+const int   NBR_STAR_TIPS = 5;                     // # points per star.               //
+constexpr StarOutline<NBR_STAR_TIPS> STAR_OUTLINE = MakeStarOutline<NBR_STAR_TIPS>();
+const float STAR_RADIUS = 0.055f;                 // Normal radius of star.           //
+const float PULSATION_FACTOR = 2.5f;                   // Extent of pulsation enlargement. //
+const int   FREEZE_INTERVAL = 6;                      // INITIAL Freeze interval (in seconds).    //
+const int   COLLISION_LIMIT = 6;					// Max possible collions for a star. //
+
+const int   TIMER_INTERVAL = 50;                     // Default # msec between simulation ticks. //
+const int   DEFAULT_SIM_HZ = 1000 / TIMER_INTERVAL;  // Default # simulation ticks per second.    //
+const int   MAX_SIM_HZ = 10000;                      // Fastest supported simulation rate.        //
+const int   TICK_CHUNK_STARS = 4096;                 // Stars per chunk of a threaded tick.       //
+const uint64_t DEFAULT_SEED = 382;                   // Star generation seed unless one is given. //
+
+// Ways of finding the stars that might collide with a given star. //
+enum BroadPhase
+{
+	BROAD_PHASE_BRUTE_FORCE,          // Test every other star.                  //
+	BROAD_PHASE_GRID,                 // Test stars in the surrounding cells.    //
+	BROAD_PHASE_SWEEP                 // Test stars within reach along sorted x. //
+};
+const char *BroadPhaseName(BroadPhase broadPhase);
+bool ParseBroadPhase(const char *name, BroadPhase &broadPhase);
+
+// When two stars count as colliding. //
+enum CollisionMode
+{
+	COLLISION_DISCRETE,               // They overlap at the end of a tick.                 //
+	COLLISION_CONTINUOUS              // They touch at any moment during a tick, first first. //
+};
+const char *CollisionModeName(CollisionMode collisionMode);
+bool ParseCollisionMode(const char *name, CollisionMode &collisionMode);
+
+// A pair of stars that collided during the latest tick. //
+struct StarContact
+{
+	float time;                       // Fraction of the tick at first touch (1 in discrete mode). //
+	int   starA;                      // The lower star index. //
+	int   starB;
+
+	/* Answering order: by time, then by the stars' indices. */
+	bool operator<(const StarContact &other) const
+	{
+		if (time != other.time)
+			return time < other.time;
+		return starA != other.starA ? starA < other.starA : starB < other.starB;
+	}
+};
+
+
+//////////////////////////////////////////////////////////
+// Simulation state shared by the windowed and headless //
+// front ends. All times are supplied by the caller, in //
+// seconds, so the world never reads a clock itself.    //
+//                                                      //
+// Stars are stored as a structure of arrays: star i is //
+// entry i of every per-star vector below, so the tick  //
+// pass streams through contiguous floats.              //
+//////////////////////////////////////////////////////////
+class StarWorld
+{
+public:
+	int    nbrStars;                  // # stars in the current game. //
+
+	// Hot per-star state, touched every tick. //
+	std::vector<float> x;             // Star center's current x-coordinate (image space). //
+	std::vector<float> y;             // Star center's current y-coordinate (image space). //
+	std::vector<float> prevX;         // Star center before the latest tick, so drawing  //
+	std::vector<float> prevY;         // can interpolate between ticks.                   //
+	std::vector<float> xInc;          // Star's x-velocity (per second).                   //
+	std::vector<float> yInc;          // Star's y-velocity (per second).                   //
+	std::vector<float> spin;          // Star's current rotated orientation.               //
+	std::vector<float> spinInc;       // Star's rotation rate (radians per second).        //
+	std::vector<float> spinCos;       // cos(spin) and sin(spin), which rotate the star's  //
+	std::vector<float> spinSin;       // outline for both drawing and boundary checks.     //
+	std::vector<float> pulsation;     // Star's current pulsation value.                   //
+	std::vector<float> pulsationInc;  // Star's pulsation rate (per second).               //
+	std::vector<float> radius;        // Star's radius (grows with collisions).            //
+
+	// Cold per-star state, touched on collisions, clicks and draws. //
+	std::vector<int>    freezeLimit;  // Star's current freeze time limit (in seconds).    //
+	std::vector<unsigned long> freezeDeadline; // Tick on which a frozen star thaws. //
+	std::vector<int>    collisionCnt; // Number of times star has collided.                //
+	std::vector<int>    stage;        // Star's collision stage, an index into stages.     //
+	std::vector<float>  basePulsationInc; // Star's pulsation and spin rates when fresh;   //
+	std::vector<float>  baseSpinInc;  // its stage scales them.                            //
+	std::vector<float>  color;        // Star's color, three floats per star.              //
+
+	BroadPhase broadPhase;            // Collision candidate search; selected at startup. //
+	CollisionMode collisionMode;      // Discrete overlap checks unless selected otherwise. //
+	KinematicsPath kinematics;        // Instruction set of the tick kernel; the widest available by default. //
+	uint64_t seed;                    // Every star's initial motion follows from this. //
+	StarStageTable stages;            // Collision stages; the game's own unless loaded at startup. //
+	float  tickSeconds;               // Simulated seconds per tick; defaults to 1/DEFAULT_SIM_HZ. //
+
+	float  windowWidth;               // Resized window width.  //
+	float  windowHeight;              // Resized window height. //
+
+	uint64_t TOTAL_COLLISIONS;        // Counter for total number of collisions. //
+	int    YELLOW_STARS;              // Counter for total number of yellow stars. //
+	int    CallInc;                   // # of "help the game along" passes performed. //
+	bool   gameOver;                  // Set once every star has turned yellow. //
+	double startTime;                 // Game start time (in seconds). //
+	int    GAME_SECONDS;              // Game time in seconds //
+	unsigned long tickCount;          // # ticks since the game was reset. //
+
+	StarEventBus *events;             // Optional bus for beeps, logs and traces; NULL for none. //
+	StarThreadPool *pool;             // Optional threads for the tick; NULL for serial. //
+	StarProfiler *profiler;           // Optional phase timer; NULL for none. //
+
+	StarWorld();
+
+	void Reset(int starCount, double currentSeconds);   // Call after SetViewport(). //
+	void SetViewport(int w, int h);
+	void Allocate(int starCount);
+	void StateChanged();
+
+	void Tick();
+	void ResolveCollisions(double currentSeconds);
+	void Step(double currentSeconds);
+
+	/* Simulated time at the end of the parameterized tick. Front ends  */
+	/* step with this, so a replay sees exactly the times the game saw. */
+	double TickTime(unsigned long tick) const { return tick * (double)tickSeconds; }
+
+	/* Distance from the indexed star's center within which another  */
+	/* star's center counts as a collision: 90% of its pulsed radius. */
+	float CollisionReach(int index) const { return 0.9f * pulsation[index] * radius[index]; }
+
+	/* # stars frozen right now, as counted by the freeze timers. */
+	int FrozenStars() const { return freezeTimers.Pending(); }
+
+	/* Position of the parameterized outline vertex of the indexed star: */
+	/* the unit outline, rotated by the star's spin and scaled by its     */
+	/* pulsed radius. Even vertices are tips, odd ones notches.           */
+	void OutlineVertex(int index, int vertex, float &vertexX, float &vertexY) const
+	{
+		PlaceOutlineVertex(STAR_OUTLINE, vertex, x[index], y[index], pulsation[index] * radius[index],
+			spinCos[index], spinSin[index], vertexX, vertexY);
+	}
+
+	void BuildBroadPhase(float headroom);
+	const std::vector<StarContact> &FindContacts();
+	void RespondToCollision(int starA, int starB);
+	void CollisionEffects(int index);
+	bool AdvanceStage(int index);
+	void ApplyStages(const int *stars, int count);
+	int  FindMouseHit(float mouseX, float mouseY);
+	void FindMouseHits(const float *mouseX, const float *mouseY, int nbrPoints, int *hits);
+	void ToggleFreeze(int index);
+
+private:
+	StarGrid  grid;                   // Grid broad phase, rebuilt every pass.  //
+	StarSweep sweep;                  // Sweep broad phase, re-sorted every pass. //
+	bool      broadPhaseStale;        // Set when the broad phase must be rebuilt before use. //
+	unsigned long broadPhaseTick;     // tickCount when the broad phase was last built. //
+	std::vector<float> reach;         // Scratch collision reach per star. //
+	std::vector<StarContact> firstContact; // Scratch: each star's earliest contact of a continuous pass. //
+	std::vector<StarContact> contacts; // Scratch contacts a pass answers, in answering order. //
+	std::vector<char>    responded;   // Scratch: set once a star has a contact to answer (discrete pass). //
+	std::vector<int>     lowestAbove; // Scratch: each star's lowest-indexed partner above it, or -1 (discrete sweep). //
+	StarTimerWheel freezeTimers;      // Each frozen star's thaw, filed by deadline. //
+	std::vector<int> thawed;          // Scratch list of the stars thawing this tick. //
+	std::vector<int> collided;        // Scratch list of the stars that answered a contact this pass. //
+	std::vector<int> staged;          // Scratch list of the stars helped to a new stage. //
+
+	// Arguments of a spawn chunk. //
+	struct SpawnContext
+	{
+		StarWorld *world;
+		float spawnExtent;
+	};
+
+	void SpawnStar(int index, float spawnExtent);
+	static void SpawnChunk(void *context, int first, int last);
+	void UpdateReach(int index);
+	int  NearestHit(float pointX, float pointY) const;
+	void IndexReach(float maxReach, float headroom);
+	bool Approaching(int starA, int starB, float separationX, float separationY) const;
+	bool ContactTime(int starA, int starB, float &time) const;
+	bool Touching(int starA, int starB, float &time) const;
+	void SweepLowestAbove();
+	int  LowestPartner(int star);
+	void BuildContactPhase();
+	template <class Visit> void ForEachContact(Visit visit);
+	void ResolveContacts();
+	void StageCollided();
+	void HelpGameAlong();
+	void Publish(StarEventType type, int starA, int starB = -1, int valueA = 0, int valueB = 0);
+};
+
+#endif
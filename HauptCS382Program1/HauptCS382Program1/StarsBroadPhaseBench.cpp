@@ -0,0 +1,177 @@
+/***********************************************************************/
+/* Filename: StarsBroadPhaseBench.cpp                                  */
+/* Compares the collision broad phases (brute force, uniform grid and */
+/* sort-and-sweep) across star counts and radius distributions. Each  */
+/* measurement rebuilds the broad phase and finds the pairs a         */
+/* collision pass would answer, exactly as it would, but without      */
+/* answering any of them; every broad phase must find the same pairs. */
+/*                                                                     */
+/* Usage: StarsBroadPhaseBench [--max-stars N] [--brute-limit N]       */
+/*                             [--density D]                           */
+/***********************************************************************/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "StarWorld.h"
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int    DEFAULT_MAX_STARS = 1000000;   // Largest population measured by default.   //
+const int    DEFAULT_BRUTE_LIMIT = 20000;   // Largest population brute force is run on. //
+const double DEFAULT_DENSITY = 3.0;         // Stars per unit area (the 12-star game's). //
+const long   MIN_QUERIES = 2000000;         // Queries per measurement, at the least...  //
+const double MAX_SECONDS = 1.0;             // ...unless that takes longer than this.    //
+const int    NBR_STAGES = 6;                // Collision stages 0 (fresh) through 5.     //
+
+// How the stars' collision stages are distributed. //
+enum RadiusDistribution
+{
+	RADII_FRESH,                            // Every star at stage 0.          //
+	RADII_MIXED,                            // Stages 0-5, uniformly.          //
+	RADII_FEW_GIANTS,                       // 1% at stage 5, the rest at 0.   //
+	NBR_RADIUS_DISTRIBUTIONS
+};
+const char *RADIUS_DISTRIBUTION_NAME[NBR_RADIUS_DISTRIBUTIONS] = { "fresh", "mixed", "few-giants" };
+
+
+/* Push the indexed star to the parameterized collision stage, using */
+/* the game's own CollisionEffects.                                  */
+static void GrowStar(StarWorld &world, int index, int stage)
+{
+	world.collisionCnt[index] = stage;
+	world.CollisionEffects(index);
+}
+
+/* Set up a square world holding the parameterized number of stars at */
+/* the parameterized density, with random pulsations and stages drawn */
+/* from the parameterized distribution.                               */
+static void PopulateWorld(StarWorld &world, int nbrStars, double density, RadiusDistribution distribution)
+{
+	float side = (float)sqrt(nbrStars / density);
+	world.windowWidth = side;
+	world.windowHeight = side;
+	world.seed = nbrStars;
+	world.Reset(nbrStars, 0.0);
+
+	for (int i = 0; i < nbrStars; i++)
+	{
+		StarRandom random(~(uint64_t)nbrStars, i);
+		world.pulsation[i] = random.Uniform(1.0f, PULSATION_FACTOR);
+		if (distribution == RADII_MIXED)
+			GrowStar(world, i, random.Below(NBR_STAGES));
+		else if (distribution == RADII_FEW_GIANTS && random.Below(100) == 0)
+			GrowStar(world, i, NBR_STAGES - 1);
+	}
+}
+
+/* Time one broad phase: rebuild, then find the pairs to answer,      */
+/* repeated until MIN_QUERIES stars have been queried or MAX_SECONDS  */
+/* have gone by. Returns milliseconds per pass, and the pairs found.  */
+static double MeasurePass(StarWorld &world, BroadPhase broadPhase, vector<StarContact> &pairs)
+{
+	world.broadPhase = broadPhase;
+	long nbrPasses = 0;
+	double elapsed = 0.0;
+
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	do
+	{
+		pairs = world.FindContacts();
+		nbrPasses++;
+		elapsed = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+	} while (nbrPasses * world.nbrStars < MIN_QUERIES && elapsed < MAX_SECONDS);
+	return 1000.0 * elapsed / nbrPasses;
+}
+
+/* Whether two passes found the same pairs, at the same times. */
+static bool SamePairs(const vector<StarContact> &pairs, const vector<StarContact> &otherPairs)
+{
+	if (pairs.size() != otherPairs.size())
+		return false;
+	for (size_t p = 0; p < pairs.size(); p++)
+		if (pairs[p] < otherPairs[p] || otherPairs[p] < pairs[p])
+			return false;
+	return true;
+}
+
+/* Print the command-line summary. */
+static void Usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [--max-stars N] [--brute-limit N] [--density D]\n", program);
+	fprintf(stderr, "  --max-stars N    largest star count measured (default %d)\n", DEFAULT_MAX_STARS);
+	fprintf(stderr, "  --brute-limit N  largest star count brute force runs on (default %d)\n", DEFAULT_BRUTE_LIMIT);
+	fprintf(stderr, "  --density D      stars per unit area (default %.1f)\n", DEFAULT_DENSITY);
+}
+
+int main(int argc, char **argv)
+{
+	long maxStars = DEFAULT_MAX_STARS;
+	long bruteLimit = DEFAULT_BRUTE_LIMIT;
+	double density = DEFAULT_DENSITY;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--max-stars") == 0 && i + 1 < argc)
+			maxStars = atol(argv[++i]);
+		else if (strcmp(argv[i], "--brute-limit") == 0 && i + 1 < argc)
+			bruteLimit = atol(argv[++i]);
+		else if (strcmp(argv[i], "--density") == 0 && i + 1 < argc)
+			density = atof(argv[++i]);
+		else
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (maxStars < 1 || maxStars > MAX_STARS || density <= 0.0)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	printf("%10s  %-10s  %-6s  %12s  %10s\n", "stars", "radii", "phase", "ms/pass", "pairs");
+	bool agree = true;
+	StarWorld world;
+	for (long nbrStars = 1000; nbrStars <= maxStars; nbrStars *= 10)
+	{
+		for (int d = 0; d < NBR_RADIUS_DISTRIBUTIONS; d++)
+		{
+			PopulateWorld(world, (int)nbrStars, density, (RadiusDistribution)d);
+
+			vector<StarContact> referencePairs;
+			bool haveReference = false;
+			for (int b = BROAD_PHASE_BRUTE_FORCE; b <= BROAD_PHASE_SWEEP; b++)
+			{
+				if (b == BROAD_PHASE_BRUTE_FORCE && nbrStars > bruteLimit)
+					continue;
+
+				vector<StarContact> pairs;
+				double milliseconds = MeasurePass(world, (BroadPhase)b, pairs);
+				printf("%10ld  %-10s  %-6s  %12.3f  %10lu\n", nbrStars, RADIUS_DISTRIBUTION_NAME[d],
+					BroadPhaseName((BroadPhase)b), milliseconds, (unsigned long)pairs.size());
+
+				// Every broad phase must answer exactly the same pairs. //
+				if (!haveReference)
+				{
+					referencePairs.swap(pairs);
+					haveReference = true;
+				}
+				else if (!SamePairs(pairs, referencePairs))
+					agree = false;
+			}
+		}
+	}
+
+	if (!agree)
+	{
+		fprintf(stderr, "broad phases disagree on the pairs to answer\n");
+		return 1;
+	}
+	return 0;
+}
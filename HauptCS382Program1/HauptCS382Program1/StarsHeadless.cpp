@@ -0,0 +1,339 @@
+/***********************************************************************/
+/* Filename: StarsHeadless.cpp                                         */
+/* Runs the pulsating stars simulation without a window: steps the    */
+/* world as fast as possible for a fixed number of ticks and reports  */
+/* the achieved tick rate.                                             */
+/*                                                                     */
+/* Usage: StarsHeadless [--ticks N] [--stars N] [--extent W H]         */
+/*                      [--broad-phase brute|grid|sweep] [--log SPEC]  */
+/*                      [--collisions discrete|continuous]             */
+/*                      [--trace FILE] [--sim-hz N]                     */
+/*                      [--kinematics scalar|sse|avx2] [--threads N]   */
+/*                      [--seed N] [--record FILE] [--replay FILE]     */
+/*                      [--load FILE] [--save FILE] [--profile]        */
+/*                      [--stages FILE]                                */
+/***********************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "StarAudio.h"
+#include "StarClock.h"
+#include "StarLog.h"
+#include "StarReplay.h"
+#include "StarSnapshot.h"
+#include "StarTrace.h"
+#include "StarWorld.h"
+using namespace std;
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const long DEFAULT_TICKS = 1000000;                    // # ticks simulated by default.    //
+const int  DEFAULT_WINDOW_SIZE[2] = { 1000, 750 };    // Window the world is sized for.   //
+
+
+/* Print the command-line summary. */
+static void Usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [--ticks N] [--stars N] [--extent W H]\n"
+		"       [--broad-phase brute|grid|sweep] [--collisions discrete|continuous]\n"
+		"       [--log SPEC] [--trace FILE]\n"
+		"       [--sim-hz N] [--kinematics scalar|sse|avx2]\n"
+		"       [--threads N] [--seed N] [--record FILE] [--replay FILE]\n"
+		"       [--load FILE] [--save FILE] [--profile] [--stages FILE]\n", program);
+	fprintf(stderr, "  --ticks N   number of ticks to simulate (default %ld)\n", DEFAULT_TICKS);
+	fprintf(stderr, "  --stars N   number of stars, 1..%d (default %d)\n", MAX_STARS, NBR_STARS);
+	fprintf(stderr, "  --extent W H  world width and height (default: a %dx%d window)\n",
+		DEFAULT_WINDOW_SIZE[0], DEFAULT_WINDOW_SIZE[1]);
+	fprintf(stderr, "  --broad-phase B  collision candidate search (default grid)\n");
+	fprintf(stderr, "  --collisions C  overlap at the end of each tick, or first touch during it\n"
+		"                  (default discrete)\n");
+	fprintf(stderr, "  --log SPEC   debug log levels, e.g. collision=info,display=off (default all=off)\n");
+	fprintf(stderr, "  --sim-hz N   simulation ticks per simulated second, 1..%d (default %d)\n",
+		MAX_SIM_HZ, DEFAULT_SIM_HZ);
+	fprintf(stderr, "  --kinematics K  instruction set of the tick kernel (default %s)\n",
+		KinematicsPathName(BestKinematicsPath()));
+	fprintf(stderr, "  --threads N  threads running the tick, 1..%d (default 1)\n", MAX_POOL_THREADS);
+	fprintf(stderr, "  --seed N     star generation seed; equal seeds replay equal games (default %llu)\n",
+		(unsigned long long)DEFAULT_SEED);
+	fprintf(stderr, "  --record FILE  write the run's seed and settings as a replay\n");
+	fprintf(stderr, "  --replay FILE  re-run a recorded game at full speed; its settings replace\n"
+		"                 --stars, --extent, --broad-phase, --collisions, --sim-hz and --seed\n");
+	fprintf(stderr, "  --load FILE  start from a world snapshot instead of a new game; its settings\n"
+		"               replace --stars, --extent, --broad-phase, --collisions, --sim-hz\n"
+		"               and --seed\n");
+	fprintf(stderr, "  --save FILE  write a world snapshot after the last tick\n");
+	fprintf(stderr, "  --profile    time each phase of every tick and report percentiles\n");
+	fprintf(stderr, "  --stages FILE  collision stages to use instead of the game's own; replays\n"
+		"                 and snapshots must have been made with the same stages\n");
+	fprintf(stderr, "  --trace FILE  write a binary event trace (rotated as FILE.1, FILE.2, ...)\n");
+}
+
+int main(int argc, char **argv)
+{
+	long nbrTicks = DEFAULT_TICKS;
+	long nbrStars = NBR_STARS;
+	long simHz = DEFAULT_SIM_HZ;
+	long nbrThreads = 1;
+	uint64_t seed = DEFAULT_SEED;
+	double extent[2] = { 0.0, 0.0 };
+	BroadPhase broadPhase = BROAD_PHASE_GRID;
+	CollisionMode collisionMode = COLLISION_DISCRETE;
+	KinematicsPath kinematics = BestKinematicsPath();
+	StarLog debugLog;
+	bool logging = false;
+	StarTrace trace;
+	StarAudio audio;                  // Null backend: beeps are merged and counted, never played. //
+	StarEventBus events;
+	const char *traceFile = NULL;
+	const char *recordFile = NULL;
+	const char *replayFile = NULL;
+	StarReplay replay;
+	const char *loadFile = NULL;
+	const char *saveFile = NULL;
+	StarProfiler profiler;
+	bool profiling = false;
+	const char *stagesFile = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+			nbrTicks = atol(argv[++i]);
+		else if (strcmp(argv[i], "--stars") == 0 && i + 1 < argc)
+			nbrStars = atol(argv[++i]);
+		else if (strcmp(argv[i], "--broad-phase") == 0 && i + 1 < argc)
+		{
+			if (!ParseBroadPhase(argv[++i], broadPhase))
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--collisions") == 0 && i + 1 < argc)
+		{
+			if (!ParseCollisionMode(argv[++i], collisionMode))
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--kinematics") == 0 && i + 1 < argc)
+		{
+			if (!ParseKinematicsPath(argv[++i], kinematics))
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+		{
+			if (!debugLog.Configure(argv[++i]))
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+			logging = true;
+		}
+		else if (strcmp(argv[i], "--sim-hz") == 0 && i + 1 < argc)
+			simHz = atol(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+			seed = strtoull(argv[++i], NULL, 0);
+		else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			nbrThreads = atol(argv[++i]);
+		else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+			recordFile = argv[++i];
+		else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+			replayFile = argv[++i];
+		else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc)
+			loadFile = argv[++i];
+		else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)
+			saveFile = argv[++i];
+		else if (strcmp(argv[i], "--profile") == 0)
+			profiling = true;
+		else if (strcmp(argv[i], "--stages") == 0 && i + 1 < argc)
+			stagesFile = argv[++i];
+		else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+			traceFile = argv[++i];
+		else if (strcmp(argv[i], "--extent") == 0 && i + 2 < argc)
+		{
+			extent[0] = atof(argv[++i]);
+			extent[1] = atof(argv[++i]);
+			if (extent[0] <= 0.0 || extent[1] <= 0.0)
+			{
+				Usage(argv[0]);
+				return 1;
+			}
+		}
+		else
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (nbrTicks <= 0 || nbrStars < 1 || nbrStars > MAX_STARS || simHz < 1 || simHz > MAX_SIM_HZ ||
+		nbrThreads < 1 || nbrThreads > MAX_POOL_THREADS)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	if ((recordFile != NULL || loadFile != NULL) && replayFile != NULL)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+	if (replayFile != NULL && !replay.Load(replayFile))
+	{
+		fprintf(stderr, "%s: %s is not a readable replay\n", argv[0], replayFile);
+		return 1;
+	}
+	StarWorld world;
+	if (stagesFile != NULL && !world.stages.Load(stagesFile))
+	{
+		fprintf(stderr, "%s: %s is not a readable stage file\n", argv[0], stagesFile);
+		return 1;
+	}
+	if (replayFile != NULL && replay.Header().stageChecksum != world.stages.Checksum())
+	{
+		fprintf(stderr, "%s: %s was recorded with other collision stages\n", argv[0], replayFile);
+		return 1;
+	}
+	if (!KinematicsPathSupported(kinematics))
+	{
+		fprintf(stderr, "%s: this processor cannot run the %s kernel\n", argv[0], KinematicsPathName(kinematics));
+		return 1;
+	}
+
+	if (logging)
+	{
+		debugLog.Open(LOG_COLLISION, "collisionFile.txt");
+		debugLog.Open(LOG_DISPLAY, "displayFile.txt");
+		debugLog.SetLossless(true);
+		debugLog.Start();
+	}
+	if (traceFile != NULL && !trace.Open(traceFile))
+	{
+		fprintf(stderr, "%s: cannot create %s\n", argv[0], traceFile);
+		return 1;
+	}
+
+	StarThreadPool pool((int)nbrThreads);
+	world.pool = &pool;
+	// The log and the trace are complete records of the run; only //
+	// the beeps, being real time, may miss events.                //
+	events.Subscribe(PlayEvents, &audio, DELIVER_DROP_WHEN_FULL);
+	if (logging)
+		events.Subscribe(LogEvents, &debugLog);
+	if (traceFile != NULL)
+		events.Subscribe(TraceEvents, &trace);
+	events.Start();
+	world.events = &events;
+	world.profiler = profiling ? &profiler : NULL;
+	world.broadPhase = broadPhase;
+	world.collisionMode = collisionMode;
+	world.kinematics = kinematics;
+	world.seed = seed;
+	world.tickSeconds = 1.0f / simHz;
+	world.SetViewport(DEFAULT_WINDOW_SIZE[0], DEFAULT_WINDOW_SIZE[1]);
+	if (extent[0] > 0.0)
+	{
+		world.windowWidth = (float)extent[0];
+		world.windowHeight = (float)extent[1];
+	}
+	world.Reset((int)nbrStars, 0.0);
+	double loadSeconds = 0.0;
+	if (loadFile != NULL)
+	{
+		int64_t loadBegin = ClockNanoseconds();
+		if (!LoadSnapshot(loadFile, world))
+		{
+			fprintf(stderr, "%s: %s is not a readable snapshot\n", argv[0], loadFile);
+			return 1;
+		}
+		loadSeconds = (ClockNanoseconds() - loadBegin) * 1e-9;
+		simHz = (long)(1.0f / world.tickSeconds + 0.5f);
+	}
+	if (replayFile != NULL)
+	{
+		replay.Setup(world);
+		simHz = replay.Header().simHz;
+		nbrTicks = (long)replay.LastTick();
+	}
+	StarReplay recording;
+	if (recordFile != NULL && !recording.Create(recordFile, world, (int)simHz))
+	{
+		fprintf(stderr, "%s: cannot create %s\n", argv[0], recordFile);
+		return 1;
+	}
+
+	// Simulated time advances by one fixed step per tick, exactly as it //
+	// would in the windowed game, regardless of how fast we run. A      //
+	// replay's input is applied between the same ticks as it was seen.  //
+	size_t nextEvent = 0;
+	int64_t begin = ClockNanoseconds();
+	for (long tick = 1; tick <= nbrTicks; tick++)
+	{
+		replay.Apply(world, nextEvent);
+		world.Step(world.TickTime(world.tickCount + 1));
+		if (profiling)
+			profiler.EndFrame();
+	}
+	int64_t end = ClockNanoseconds();
+	events.Stop();
+	trace.Close();
+	recording.Finish(world);
+	if (saveFile != NULL && !SaveSnapshot(saveFile, world))
+	{
+		fprintf(stderr, "%s: cannot write %s\n", argv[0], saveFile);
+		return 1;
+	}
+
+	double elapsed = (end - begin) * 1e-9;
+	printf("stars:            %d\n", world.nbrStars);
+	printf("seed:             %llu\n", (unsigned long long)world.seed);
+	printf("extent:           %.2f x %.2f\n", world.windowWidth, world.windowHeight);
+	printf("broad phase:      %s\n", BroadPhaseName(world.broadPhase));
+	printf("collisions:       %s\n", CollisionModeName(world.collisionMode));
+	printf("kinematics:       %s\n", KinematicsPathName(world.kinematics));
+	printf("threads:          %d (%lu steals)\n", pool.ThreadCount(), pool.Steals());
+	if (loadFile != NULL)
+		printf("snapshot:         loaded at tick %lu in %.1f ms\n", world.tickCount - nbrTicks, 1000.0 * loadSeconds);
+	printf("ticks:            %ld at %ld Hz\n", nbrTicks, simHz);
+	printf("elapsed (sec):    %.3f\n", elapsed);
+	printf("ticks/sec:        %.0f\n", elapsed > 0.0 ? nbrTicks / elapsed : 0.0);
+	printf("total collisions: %llu\n", (unsigned long long)world.TOTAL_COLLISIONS);
+	printf("yellow stars:     %d\n", world.YELLOW_STARS);
+	printf("game seconds:     %d%s\n", world.GAME_SECONDS, world.gameOver ? " (game over)" : "");
+	printf("events:           %lu published, %lu dropped (audio), %lu stalls\n",
+		events.Published(), events.Dropped(), events.Stalls());
+	printf("beeps:            %lu requested, %lu voices\n", audio.Posted(), audio.Played());
+	if (profiling)
+	{
+		printf("\n");
+		profiler.Report(stdout);
+	}
+
+	// The log and the trace must hold every event of the run. //
+	if (debugLog.Dropped() > 0 || trace.Dropped() > 0)
+	{
+		printf("events:           LOST; %lu log lines, %lu trace records dropped\n",
+			debugLog.Dropped(), trace.Dropped());
+		return 3;
+	}
+
+	// A finished recording also says how the game ended. //
+	const ReplayHeader &recorded = replay.Header();
+	if (replayFile != NULL && recorded.nbrTicks > 0)
+	{
+		if (recorded.totalCollisions == world.TOTAL_COLLISIONS && recorded.gameSeconds == world.GAME_SECONDS)
+			printf("replay:           matches the recording\n");
+		else
+		{
+			printf("replay:           DIFFERS; recorded %llu collisions, %d game seconds\n",
+				(unsigned long long)recorded.totalCollisions, recorded.gameSeconds);
+			return 2;
+		}
+	}
+	return 0;
+}
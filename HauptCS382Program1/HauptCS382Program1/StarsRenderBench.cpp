@@ -0,0 +1,187 @@
+/***********************************************************************/
+/* Filename: StarsRenderBench.cpp                                      */
+/* Compares immediate-mode star drawing (glBegin/glEnd per star) with */
+/* StarRenderer's single-call vertex buffer path, off screen. The GL  */
+/* context comes from EGL on a pbuffer, so the benchmark also runs on */
+/* machines without a GPU or a display through Mesa's software       */
+/* rasterizer. Each path is timed twice: drawing for real, and with  */
+/* rasterization discarded, which leaves the per-frame submission and */
+/* vertex cost that the vertex buffer is meant to cut.                */
+/*                                                                     */
+/* Usage: StarsRenderBench [--max-stars N] [--frames N]                */
+/***********************************************************************/
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "StarRenderer.h"
+using namespace std;
+
+#ifndef GL_RASTERIZER_DISCARD
+#define GL_RASTERIZER_DISCARD 0x8C89
+#endif
+
+//////////////////////
+// Global Constants //
+//////////////////////
+const int DEFAULT_MAX_STARS = 100000;                 // Largest population drawn by default. //
+const int DEFAULT_FRAMES = 20;                        // Frames timed per measurement.         //
+const int WINDOW_SIZE[2] = { 1000, 750 };             // Off-screen surface, in pixels.        //
+
+
+/* Print the command-line summary. */
+static void Usage(const char *program)
+{
+	fprintf(stderr, "usage: %s [--max-stars N] [--frames N]\n", program);
+	fprintf(stderr, "  --max-stars N  largest star count drawn, from 1000 up by 10x (default %d)\n", DEFAULT_MAX_STARS);
+	fprintf(stderr, "  --frames N     frames timed per measurement (default %d)\n", DEFAULT_FRAMES);
+}
+
+static StarGLProc LoadGLProc(const char *name)
+{
+	return (StarGLProc)eglGetProcAddress(name);
+}
+
+/* Make a GL context current on an off-screen pbuffer. Prefers Mesa's */
+/* surfaceless platform, which needs no display server at all.        */
+static bool CreateContext()
+{
+	EGLDisplay display = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+		(PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (getPlatformDisplay != NULL)
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	if (display == EGL_NO_DISPLAY)
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	EGLint major, minor;
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor))
+		return false;
+
+	const EGLint configAttributes[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_NONE };
+	const EGLint surfaceAttributes[] = { EGL_WIDTH, WINDOW_SIZE[0], EGL_HEIGHT, WINDOW_SIZE[1], EGL_NONE };
+	EGLConfig config;
+	EGLint nbrConfigs;
+	if (!eglChooseConfig(display, configAttributes, &config, 1, &nbrConfigs) || nbrConfigs < 1)
+		return false;
+	EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+	if (surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API))
+		return false;
+	EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+	return context != EGL_NO_CONTEXT && eglMakeCurrent(display, surface, surface, context);
+}
+
+/* The same projection the game sets up for a window of this size. */
+static void SetProjection(const StarWorld &world)
+{
+	glViewport(0, 0, WINDOW_SIZE[0], WINDOW_SIZE[1]);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	glOrtho(-world.windowWidth / 2.0, world.windowWidth / 2.0, -world.windowHeight / 2.0, world.windowHeight / 2.0, -10.0, 10.0);
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	glLineWidth(2);
+}
+
+/* The game's immediate-mode path: one glBegin/glEnd per star. */
+static void DrawImmediate(const StarFrame &frame, float alpha)
+{
+	for (int i = 0; i < frame.nbrStars; i++)
+	{
+		float shiftX = (1.0f - alpha) * (frame.prevX[i] - frame.x[i]);
+		float shiftY = (1.0f - alpha) * (frame.prevY[i] - frame.y[i]);
+		glColor3fv(&frame.color[3 * i]);
+		glBegin(GL_LINE_LOOP);
+		for (int j = 0; j < VERTICES_PER_STAR; j++)
+		{
+			float vertexX, vertexY;
+			frame.OutlineVertex(i, j, vertexX, vertexY);
+			glVertex2f(vertexX + shiftX, vertexY + shiftY);
+		}
+		glEnd();
+	}
+}
+
+/* Average milliseconds per frame, submitting frames back to back and */
+/* waiting for the GPU once at the end; the world ticks and is captured */
+/* between frames, as the game's simulation thread does, so the        */
+/* vertices really change.                                             */
+static double TimeFrames(StarWorld &world, StarRenderer *renderer, int nbrFrames)
+{
+	StarFrame frame;
+	chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+	for (int f = 0; f < nbrFrames; f++)
+	{
+		world.Tick();
+		frame.Capture(world, 0.0, 0.0);
+		glClear(GL_COLOR_BUFFER_BIT);
+		if (renderer != NULL)
+			renderer->Draw(frame, 0.5f);
+		else
+			DrawImmediate(frame, 0.5f);
+	}
+	glFinish();
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return 1000.0 * chrono::duration<double>(end - begin).count() / nbrFrames;
+}
+
+int main(int argc, char **argv)
+{
+	long maxStars = DEFAULT_MAX_STARS;
+	long nbrFrames = DEFAULT_FRAMES;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--max-stars") == 0 && i + 1 < argc)
+			maxStars = atol(argv[++i]);
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			nbrFrames = atol(argv[++i]);
+		else
+		{
+			Usage(argv[0]);
+			return 1;
+		}
+	}
+	if (maxStars < 1 || maxStars > MAX_STARS || nbrFrames < 1)
+	{
+		Usage(argv[0]);
+		return 1;
+	}
+
+	if (!CreateContext())
+	{
+		fprintf(stderr, "%s: no EGL/OpenGL context available\n", argv[0]);
+		return 1;
+	}
+	StarRenderer renderer;
+	if (!renderer.Init(LoadGLProc))
+	{
+		fprintf(stderr, "%s: vertex buffers not supported\n", argv[0]);
+		return 1;
+	}
+	printf("renderer: %s, GL %s\n", (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+
+	StarWorld world;
+	world.SetViewport(WINDOW_SIZE[0], WINDOW_SIZE[1]);
+	SetProjection(world);
+
+	printf("milliseconds per frame\n");
+	printf("%10s  %12s  %12s  %18s  %18s\n", "stars", "immediate", "streamed", "immediate (no ras)", "streamed (no ras)");
+	for (long nbrStars = 1000; nbrStars <= maxStars; nbrStars *= 10)
+	{
+		world.Reset((int)nbrStars, 0.0);
+		double immediate = TimeFrames(world, NULL, (int)nbrFrames);
+		double streamed = TimeFrames(world, &renderer, (int)nbrFrames);
+		glEnable(GL_RASTERIZER_DISCARD);
+		double immediateSubmit = TimeFrames(world, NULL, (int)nbrFrames);
+		double streamedSubmit = TimeFrames(world, &renderer, (int)nbrFrames);
+		glDisable(GL_RASTERIZER_DISCARD);
+		printf("%10ld  %12.3f  %12.3f  %18.3f  %18.3f\n", nbrStars, immediate, streamed, immediateSubmit, streamedSubmit);
+	}
+	printf("vertex buffer: %s\n", renderer.Persistent() ? "persistent, triple-buffered" : "orphaned each frame");
+	renderer.Shutdown();
+	return 0;
+}